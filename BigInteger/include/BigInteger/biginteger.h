@@ -3,6 +3,8 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
 #include <algorithm>
 #include <stdexcept>
 #include <immintrin.h>
@@ -10,33 +12,285 @@
 #include <complex>
 #include <sstream>
 #include <stack>
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
 
 #include <limits>
 
 namespace Biginteger{
     
     
+    // 每个 limb 存 9 位十进制数（10^9 进制），十进制只在 from_string/to_string 处转换
+    using limb_t = uint32_t;
+    const limb_t BASE = 1000000000;
+    const int BASE_DIGITS = 9;
+
+    // 可选的运行统计：以 -DBIGINTEGER_STATS=ON 构建时，各算法的入口记录调用次数、操作数规模分布、
+    // 耗时和分配的字节数；未开启时记录点展开为空，查询接口返回全零
+    enum class StatCounter {
+        Add, Sub, SmallMul, SmallDiv,
+        Schoolbook, Karatsuba, Toom3, Toom4, FFT, NTT,
+        Knuth, BurnikelZiegler, Newton, Reciprocal, PowMod, Gcd, HalfGcd, Sqrt, Root, Product,
+        BinarySplitting,
+        ToString, FromString, DivideDecimal, Evaluate,
+        Count
+    };
+    const size_t STAT_BUCKETS = 32; // 规模分布的第 k 格统计 [2^k, 2^(k+1)) 个 limb 的调用，0 计入第 0 格
+
+    struct OperationStats {
+        uint64_t calls = 0;
+        uint64_t nanoseconds = 0; // 各线程上的独占耗时：只扣除同一线程上内层记录的调用，等待其他线程的时间也算在内
+        uint64_t bytes = 0;       // limb 存储与临时缓冲块，记在分配时所在线程最内层的记录上
+        std::array<uint64_t, STAT_BUCKETS> sizes{};
+    };
+
+    bool stats_enabled();
+    const char* stat_name(StatCounter counter);
+    std::vector<OperationStats> stats(); // 按 StatCounter 的顺序
+    void reset_stats();
+    std::string stats_json();
+
+#ifdef BIGINTEGER_STATS
+    void note_allocation(size_t bytes);
+
+    // 记录点：构造时开始计时，析构时把耗时（扣除内层记录点）和其间的分配计入 counter
+    class StatScope {
+    public:
+        StatScope(StatCounter counter, size_t limbs);
+        ~StatScope();
+        StatScope(const StatScope&) = delete;
+        StatScope& operator=(const StatScope&) = delete;
+    private:
+        friend void note_allocation(size_t bytes);
+        StatCounter counter;
+        StatScope* parent;
+        uint64_t start;
+        uint64_t nested = 0;
+        uint64_t bytes = 0;
+    };
+
+    #define BIGINTEGER_STAT(counter, limbs) ::Biginteger::StatScope bigint_stat_scope_(::Biginteger::StatCounter::counter, (limbs))
+    #define BIGINTEGER_STAT_ALLOC(bytes) ::Biginteger::note_allocation(bytes)
+#else
+    #define BIGINTEGER_STAT(counter, limbs) ((void)0)
+    #define BIGINTEGER_STAT_ALLOC(bytes) ((void)0)
+#endif
+
+    // limb 序列，接口是 std::vector<limb_t> 的子集。不超过 INLINE_LIMBS 个（54 位十进制）时
+    // 存放在对象内部，不访问堆；超出后才转到堆上，之后容量只增不减
+    class LimbVector {
+    public:
+        using value_type = limb_t;
+        using size_type = size_t;
+        using iterator = limb_t*;
+        using const_iterator = const limb_t*;
+        static const size_t INLINE_LIMBS = 6;
+
+        LimbVector() noexcept : ptr(local), len(0), cap(INLINE_LIMBS) {}
+        explicit LimbVector(size_t n, limb_t value = 0) : LimbVector() { assign(n, value); }
+        LimbVector(std::initializer_list<limb_t> init) : LimbVector() { assign(init.begin(), init.end()); }
+        template <class It, class = std::enable_if_t<!std::is_integral_v<It>>>
+        LimbVector(It first, It last) : LimbVector() { assign(first, last); }
+        LimbVector(const LimbVector& other) : LimbVector() { assign(other.begin(), other.end()); }
+        LimbVector(LimbVector&& other) noexcept : LimbVector() { steal(other); }
+        ~LimbVector() { release(); }
+
+        LimbVector& operator=(const LimbVector& other) {
+            if (this != &other) assign(other.begin(), other.end());
+            return *this;
+        }
+        LimbVector& operator=(LimbVector&& other) noexcept {
+            if (this != &other) {
+                release();
+                ptr = local;
+                cap = INLINE_LIMBS;
+                steal(other);
+            }
+            return *this;
+        }
+
+        size_t size() const { return len; }
+        size_t capacity() const { return cap; }
+        bool empty() const { return len == 0; }
+        limb_t* data() { return ptr; }
+        const limb_t* data() const { return ptr; }
+        limb_t* begin() { return ptr; }
+        limb_t* end() { return ptr + len; }
+        const limb_t* begin() const { return ptr; }
+        const limb_t* end() const { return ptr + len; }
+        limb_t& operator[](size_t i) { return ptr[i]; }
+        const limb_t& operator[](size_t i) const { return ptr[i]; }
+        limb_t& front() { return ptr[0]; }
+        const limb_t& front() const { return ptr[0]; }
+        limb_t& back() { return ptr[len - 1]; }
+        const limb_t& back() const { return ptr[len - 1]; }
+
+        void reserve(size_t n) {
+            if (n > cap) reallocate(n);
+        }
+        void resize(size_t n, limb_t value = 0) {
+            if (n > cap) reallocate(std::max(n, grown_capacity()));
+            if (n > len) std::fill(ptr + len, ptr + n, value);
+            len = n;
+        }
+        void clear() { len = 0; }
+        void push_back(limb_t value) {
+            if (len == cap) reallocate(grown_capacity());
+            ptr[len++] = value;
+        }
+        void pop_back() { --len; }
+        void assign(size_t n, limb_t value) {
+            len = 0;
+            resize(n, value);
+        }
+        // 允许来自其他元素类型（如 uint64_t 累加器）的区间，逐个截断为 limb
+        template <class It, class = std::enable_if_t<!std::is_integral_v<It>>>
+        void assign(It first, It last) {
+            const size_t n = (size_t)std::distance(first, last);
+            if (n > cap) {
+                // 先复制再释放，源区间可以是自身的一部分
+                LimbVector fresh;
+                fresh.reallocate(n);
+                std::transform(first, last, fresh.ptr, [](auto v) { return (limb_t)v; });
+                fresh.len = n;
+                *this = std::move(fresh);
+                return;
+            }
+            std::transform(first, last, ptr, [](auto v) { return (limb_t)v; });
+            len = n;
+        }
+        void swap(LimbVector& other) noexcept {
+            LimbVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        friend bool operator==(const LimbVector& a, const LimbVector& b) {
+            return a.len == b.len && std::equal(a.begin(), a.end(), b.begin());
+        }
+        friend bool operator!=(const LimbVector& a, const LimbVector& b) { return !(a == b); }
+
+    private:
+        limb_t* ptr;
+        size_t len, cap;
+        limb_t local[INLINE_LIMBS];
+
+        bool on_heap() const { return ptr != local; }
+        size_t grown_capacity() const { return std::max(2 * cap, 2 * INLINE_LIMBS); }
+        void release() {
+            if (on_heap()) ::operator delete(ptr);
+        }
+        void reallocate(size_t n) {
+            BIGINTEGER_STAT_ALLOC(n * sizeof(limb_t));
+            limb_t* fresh = static_cast<limb_t*>(::operator new(n * sizeof(limb_t)));
+            std::copy(ptr, ptr + len, fresh);
+            release();
+            ptr = fresh;
+            cap = n;
+        }
+        // 堆上的缓冲区直接接管，内部缓冲区只能复制；调用前 *this 必须为空的内部状态
+        void steal(LimbVector& other) noexcept {
+            if (other.on_heap()) {
+                ptr = other.ptr;
+                cap = other.cap;
+                other.ptr = other.local;
+                other.cap = INLINE_LIMBS;
+            } else {
+                std::copy(other.local, other.local + other.len, local);
+            }
+            len = other.len;
+            other.len = 0;
+        }
+    };
+
     struct BigInteger {
-        std::vector<int> digits;  // 低位在前存储
+        LimbVector digits;  // 低位在前存储，每个元素是一个 limb
         bool is_negative = false;
     };
 
-    const size_t KARATSUBA_THRESHOLD = 32;
-    const size_t FFT_THRESHOLD = 1000;
+    // 阈值均以 limb 个数计；除 NTT_THRESHOLD 外都按较短操作数的长度比较
+    // 这里是默认值，运行时以 thresholds() 为准
+    const size_t KARATSUBA_THRESHOLD = 48;
+    const size_t TOOM3_THRESHOLD = 128;
+    const size_t TOOM4_THRESHOLD = 192;
+    const size_t FFT_THRESHOLD = 256;
+    const size_t NTT_THRESHOLD = 32768; // 两操作数总长超过该值时 double FFT 的舍入误差不再可靠，改用精确的 NTT；调优结果不会超过它
+    const size_t NTT_MAX_LENGTH = size_t(1) << 25; // 三个模数能容纳的最长卷积；更长的乘积先用 Karatsuba 拆开
+    // 除法按除数与商中较短者的长度比较
+    const size_t BZ_THRESHOLD = 128;
+    const size_t NEWTON_THRESHOLD = 262144; // Newton 倒数要多做几次全长乘法，只在很大时才追上 Burnikel–Ziegler
+    const size_t HGCD_THRESHOLD = 128; // gcd 从该长度起用半 GCD 递归，更短时用 Lehmer
+    const size_t PARALLEL_THRESHOLD = 2048; // 乘法的递归子乘积与 NTT 的各模数从该长度起交给线程池并行执行
     const double PI = acos(-1.0);
 
+    // 各算法的切换点，可由 tune 生成的配置文件覆盖
+    struct Thresholds {
+        size_t karatsuba = KARATSUBA_THRESHOLD;
+        size_t toom3 = TOOM3_THRESHOLD;
+        size_t toom4 = TOOM4_THRESHOLD;
+        size_t fft = FFT_THRESHOLD;
+        size_t ntt = NTT_THRESHOLD;
+        size_t ntt_max = NTT_MAX_LENGTH; // 单次 NTT 的最大总长，调低可减少超大乘法的内存；不会超过 NTT_MAX_LENGTH
+        size_t bz = BZ_THRESHOLD;
+        size_t newton = NEWTON_THRESHOLD;
+        size_t hgcd = HGCD_THRESHOLD;
+        size_t parallel = PARALLEL_THRESHOLD;
+    };
+
+    // 首次调用时若设置了环境变量 BIGINTEGER_TUNING，则从该文件加载；应在开始计算前修改
+    Thresholds& thresholds();
+    Thresholds read_thresholds(const std::string& path);
+    void load_thresholds(const std::string& path);
+    void save_thresholds(const Thresholds& t, const std::string& path);
+
+    // 库内部的工作窃取线程池。线程数默认取硬件并发数，可由环境变量 BIGINTEGER_THREADS
+    // 或 set_thread_count 修改（不要在计算进行中调用）；为 1 时完全串行
+    void set_thread_count(size_t n);
+    size_t thread_count();
+    // 并行执行彼此独立的任务并等待全部完成，可嵌套调用；limbs 小于 thresholds().parallel 时串行
+    void parallel_invoke(const std::vector<std::function<void()>>& tasks, size_t limbs);
+    // 把 [begin, end) 分成不超过线程数、每块至少 grain 个元素的区间并行执行 body(lo, hi)
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    // 线程局部的临时缓冲区，按栈的方式使用：ScratchFrame 析构时释放其间取得的全部空间（内容未初始化）。
+    // 缓冲块只增不减，同一线程反复计算时不再调用 malloc，多线程下也就没有分配器竞争
+    class ScratchFrame {
+    public:
+        ScratchFrame();
+        ~ScratchFrame();
+        ScratchFrame(const ScratchFrame&) = delete;
+        ScratchFrame& operator=(const ScratchFrame&) = delete;
+        limb_t* limbs(size_t n);
+        uint64_t* words(size_t n);
+        std::complex<double>* complexes(size_t n);
+    private:
+        size_t block, used;
+    };
+
     void fft(std::vector<std::complex<double>>& a, bool inv);
     void remove_leading_zeros(BigInteger& num);
     void pad_zeros(BigInteger& num, size_t target_len);
     BigInteger get_lower(const BigInteger& num, size_t n);
     BigInteger get_upper(const BigInteger& num, size_t n);
+    // 同上，但去掉前导零，结果可以直接参与运算
+    BigInteger lower(const BigInteger& num, size_t n);
+    BigInteger upper(const BigInteger& num, size_t n);
+    BigInteger power_of_base(size_t n); // BASE^n
+    bool is_zero(const BigInteger& num);
+    size_t trimmed_length(const limb_t* x, size_t n); // x[0..n) 去掉前导零后的长度
     BigInteger shift_left(const BigInteger& num, size_t shift);
 
     int compare_abs(const BigInteger& a, const BigInteger& b);
     BigInteger from_longlong(long long x = 0);
 
+    // 右值版本直接改写并移交参数的缓冲区
     BigInteger absolute(const BigInteger& num);
+    BigInteger absolute(BigInteger&& num);
     BigInteger negate(const BigInteger& num);
+    BigInteger negate(BigInteger&& num);
 
     BigInteger from_string(const std::string& s);
     // std::string to_string(const BigInteger& num);
@@ -46,27 +300,171 @@ namespace Biginteger{
     BigInteger multiply_abs(const BigInteger& a, const BigInteger &b);
     BigInteger karatsuba(const BigInteger& a, const BigInteger& b);
     BigInteger karatsuba_avx512(const BigInteger& a, const BigInteger& b);
-    BigInteger FFT_multiply(BigInteger a, BigInteger b);
+    BigInteger toom3(const BigInteger& a, const BigInteger& b);
+    BigInteger toom4(const BigInteger& a, const BigInteger& b);
+    BigInteger multiply_dispatch(const BigInteger& a, const BigInteger& b);
+    BigInteger FFT_multiply(const BigInteger& a, const BigInteger& b);
+    BigInteger NTT_multiply(const BigInteger& a, const BigInteger& b);
+    // 区间版本：out[0..na+nb) = a * b，out 不能与 a、b 重叠，变换缓冲取自 ScratchFrame
+    void fft_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb);
+    void ntt_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb);
     BigInteger divide(const BigInteger& dividend, const BigInteger& divisor, BigInteger& remainder);
+    // 以下除法均要求非负操作数且除数非零
+    BigInteger divide_abs(const BigInteger& a, const BigInteger& b, BigInteger& remainder);
+    BigInteger divide_knuth(const BigInteger& a, const BigInteger& b, BigInteger& remainder);
+    BigInteger divide_bz(const BigInteger& a, const BigInteger& b, BigInteger& remainder);
+    BigInteger divide_newton(const BigInteger& a, const BigInteger& b, BigInteger& remainder);
+    BigInteger reciprocal(const BigInteger& b);
+
+    // 固定模数的模运算：预先算好约简所需的常数，同一模数上的大量模幂可以共用。
+    // 模数与 BASE 互素（不含因子 2 和 5）时模幂在 Montgomery 形式下进行，否则用 Barrett 约简
+    struct ModContext {
+        BigInteger modulus;
+        size_t n = 0;              // 模数的 limb 数
+        bool montgomery = false;
+        limb_t inverse_word = 0;   // -modulus^{-1} mod BASE
+        BigInteger inverse;        // modulus^{-1} mod BASE^n，模数不短于 FFT 阈值时才计算，为空时逐 limb 约简
+        BigInteger r2;             // BASE^(2n) mod modulus
+        BigInteger mu;             // floor(BASE^(2n) / modulus)
+    };
+
+    ModContext mod_context(const BigInteger& modulus);
+    BigInteger mod_reduce(const ModContext& ctx, const BigInteger& x); // 结果在 [0, modulus)，x 可以为负
+    BigInteger mod_mul(const ModContext& ctx, const BigInteger& a, const BigInteger& b);
+    BigInteger powmod(const ModContext& ctx, const BigInteger& base, const BigInteger& exp); // exp 为负时对 base 的模逆求幂
+    BigInteger powmod(const BigInteger& base, const BigInteger& exp, const BigInteger& modulus);
+
+    // 最大公约数，结果非负。xgcd 另求 s、t 使 s a + t b = gcd；b 不为零时 s 规范到 |s| < |b| / gcd。
+    // 较短时用 Lehmer（每步由最高两个 limb 得出系数矩阵），较长时用建立在快速乘法上的半 GCD 递归
+    BigInteger gcd(const BigInteger& a, const BigInteger& b);
+    BigInteger xgcd(const BigInteger& a, const BigInteger& b, BigInteger& s, BigInteger& t);
+    BigInteger modinv(const BigInteger& a, const BigInteger& modulus); // 结果在 [0, modulus)，不互素时抛出异常
+
+    // 整数平方根与 k 次方根（向零截断），remainder 为 num 减去根的 k 次幂。
+    // 平方根用倒数平方根的 Newton 迭代，只做乘法；k 次方根从高位部分的根出发，每步精度翻倍
+    BigInteger isqrt(const BigInteger& num);
+    BigInteger isqrt(const BigInteger& num, BigInteger& remainder);
+    BigInteger iroot(const BigInteger& num, int64_t k);
+    BigInteger iroot(const BigInteger& num, int64_t k, BigInteger& remainder);
+
+    // 乘积树：按长度对半分的平衡二叉树，子树足够大时并行计算，空序列的乘积为 1。
+    // factorial、binomial 先分解成素数幂，再按指数的二进制位平方累乘
+    BigInteger product(std::span<const BigInteger> nums);
+    BigInteger factorial(int64_t n);
+    BigInteger binomial(int64_t n, int64_t k);
+    BigInteger primorial(int64_t n); // 不超过 n 的素数之积
+
+    // 数学常数：compute_constant 返回 floor(c · 10^digits)，constant_string 返回带小数点、恰好 digits 位小数的截断值。
+    // pi 用 Chudnovsky 级数，e 用 Σ 1/k!，log2 用三个 atanh 级数的 Machin 型公式，都以二分法（binary splitting）
+    // 分段并行求和，再做一次 Newton 除法；sqrt2 直接开方。checkpoint 非空时每算完一段就写入该文件，
+    // 中断后以相同参数重跑会跳过已完成的部分
+    enum class Constant { Pi, E, Log2, Sqrt2 };
+    const char* constant_name(Constant c);
+    Constant constant_from_name(const std::string& name); // 未知名字抛出异常
+    BigInteger compute_constant(Constant c, size_t digits, const std::string& checkpoint = "");
+    std::string constant_string(Constant c, size_t digits, const std::string& checkpoint = "");
+
+    // 写入已有对象的版本：out 可以是 a 或 b 本身，容量足够时加减法不分配内存
+    void add(BigInteger& out, const BigInteger& a, const BigInteger& b);
+    void sub(BigInteger& out, const BigInteger& a, const BigInteger& b);
+    void mul(BigInteger& out, const BigInteger& a, const BigInteger& b);
 
     BigInteger operator+(const BigInteger& a, const BigInteger& b);
     BigInteger operator-(const BigInteger& a, const BigInteger& b);
+    // 临时对象参与加减时复用它的缓冲区，a + b + c 这样的链只分配一次
+    BigInteger operator+(BigInteger&& a, const BigInteger& b);
+    BigInteger operator+(const BigInteger& a, BigInteger&& b);
+    BigInteger operator+(BigInteger&& a, BigInteger&& b);
+    BigInteger operator-(BigInteger&& a, const BigInteger& b);
+    BigInteger operator-(const BigInteger& a, BigInteger&& b);
+    BigInteger operator-(BigInteger&& a, BigInteger&& b);
     BigInteger operator*(const BigInteger& a, const BigInteger& b);
     bool operator<(const BigInteger& a, const BigInteger& b);
+    bool operator>(const BigInteger& a, const BigInteger& b);
+    bool operator<=(const BigInteger& a, const BigInteger& b);
+    bool operator>=(const BigInteger& a, const BigInteger& b);
     bool operator==(const BigInteger& a, const BigInteger& b);
     BigInteger operator/(const BigInteger& a, const BigInteger& b);
     BigInteger operator%(const BigInteger& a, const BigInteger& b);
+    BigInteger& operator+=(BigInteger& a, const BigInteger& b);
+    BigInteger& operator-=(BigInteger& a, const BigInteger& b);
+    BigInteger& operator*=(BigInteger& a, const BigInteger& b);
+    BigInteger& operator/=(BigInteger& a, const BigInteger& b);
+    BigInteger& operator%=(BigInteger& a, const BigInteger& b);
 
+    // 与机器整数的运算：单趟线性扫描，原地版本不分配临时 BigInteger
+    void add_small(BigInteger& num, int64_t k);
+    void sub_small(BigInteger& num, int64_t k);
+    void mul_small(BigInteger& num, int64_t k);
+    void mul_add_small(BigInteger& num, int64_t k, int64_t c); // num = num * k + c
+    int64_t divmod_small(BigInteger& num, int64_t d);          // num 变为商，返回余数
+    int compare_small(const BigInteger& a, int64_t k);
+
+    BigInteger operator+(const BigInteger& a, int64_t k);
+    BigInteger operator-(const BigInteger& a, int64_t k);
+    BigInteger operator*(const BigInteger& a, int64_t k);
+    BigInteger operator*(int64_t k, const BigInteger& a);
+    BigInteger operator/(const BigInteger& a, int64_t d);
+    int64_t operator%(const BigInteger& a, int64_t d);
+    BigInteger operator+(BigInteger&& a, int64_t k);
+    BigInteger operator-(BigInteger&& a, int64_t k);
+    BigInteger operator*(BigInteger&& a, int64_t k);
+    BigInteger operator/(BigInteger&& a, int64_t d);
+    BigInteger& operator+=(BigInteger& a, int64_t k);
+    BigInteger& operator-=(BigInteger& a, int64_t k);
+    BigInteger& operator*=(BigInteger& a, int64_t k);
+    BigInteger& operator/=(BigInteger& a, int64_t d);
+    BigInteger& operator%=(BigInteger& a, int64_t d);
+    bool operator<(const BigInteger& a, int64_t k);
+    bool operator>(const BigInteger& a, int64_t k);
+    bool operator<=(const BigInteger& a, int64_t k);
+    bool operator>=(const BigInteger& a, int64_t k);
+    bool operator==(const BigInteger& a, int64_t k);
+
+    // SIMD 内核有 AVX-512、AVX2 和标量三套，启动时按 CPUID 选择，可由环境变量
+    // BIGINTEGER_SIMD=avx512|avx2|scalar 或 set_simd_level 改低（不能超过 CPU 支持的级别）
+    enum class SimdLevel { Scalar, AVX2, AVX512 };
+    SimdLevel simd_level();
+    SimdLevel cpu_simd_level();
+    void set_simd_level(SimdLevel level);
+    const char* simd_level_name(SimdLevel level);
+
+    // 幅值逐 limb 加减：out[0..nx) = x ± y，要求 nx >= ny（减法还要求 x >= y），返回最高位的进位/借位。
+    // 重叠部分由 SIMD 进位超前内核处理；out 可以与 x 相同
+    limb_t add_limbs(limb_t* out, const limb_t* x, size_t nx, const limb_t* y, size_t ny);
+    limb_t sub_limbs(limb_t* out, const limb_t* x, size_t nx, const limb_t* y, size_t ny);
+
+    // 竖式乘法：out[0..na+nb) = a * b，out 不能与 a、b 重叠；累加器取自 ScratchFrame
+    void multiply_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb);
+    // 区间上的乘法阶梯：out[0..na+nb) = a * b，out 不能与 a、b 重叠，scratch 至少 mul_scratch(na, nb) 个 limb。
+    // 竖式、Karatsuba、Toom 和长度悬殊时的分段都在 scratch 里完成，FFT/NTT 的变换缓冲取自 ScratchFrame
+    size_t mul_scratch(size_t na, size_t nb);
+    void mul_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch);
+    // Toom-3/Toom-4 的区间版本，要求 na >= nb > na / 2
+    size_t toom3_scratch(size_t na, size_t nb);
+    void toom3_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch);
+    size_t toom4_scratch(size_t na, size_t nb);
+    void toom4_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch);
+    // Montgomery 约简：out[0..n] = t * BASE^{-n} mod m，结果不超过 2m，要求 nt <= 2n、t < m * BASE^n、
+    // inv = -m^{-1} mod BASE；out 可以与 t 相同，逐行累加与竖式乘法共用 SIMD 内核
+    void redc_limbs(limb_t* out, const limb_t* t, size_t nt, const limb_t* m, size_t n, limb_t inv);
+
+    // 名字沿用历史，实际使用 simd_level() 选中的内核
     void add_with_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b);
     void multiply_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b);
     
     long long to_longlong(BigInteger& a);
     std::string to_string(const BigInteger& num);
+    std::ostream& operator<<(std::ostream& os, const BigInteger& num);
 
 
+    // a / b 的十进制展开，保留 precision 位小数（向零截断），展开提前终止时不补零
     std::string divide_decimal(const BigInteger& a, const BigInteger& b, int precision);
+    // 同上，但把结果分段交给 sink：先是符号与整数部分，再是小数点和按块求出的各段小数，
+    // 不必把整个结果放进一个字符串。小数部分由一次 Newton 倒数按块求出，每块只需两次乘法
+    void divide_decimal_stream(const BigInteger& a, const BigInteger& b, size_t precision,
+                               const std::function<void(std::string_view)>& sink);
     BigInteger multiply_by_10(const BigInteger& num);
-    std::string evaluate_expression(const std::string& expr, int precision = 10);
     // 扩展的表达式解析功能
     BigInteger evaluate_expression(const std::string& expr);
     BigInteger eval(const std::vector<std::string>& tokens, size_t& index);
@@ -80,5 +478,44 @@ namespace Biginteger{
     BigInteger integer_divide(const BigInteger& a, const BigInteger& b);
     BigInteger sum(const std::vector<BigInteger>& nums);
     BigInteger max(const std::vector<BigInteger>& nums);
+
+    // 预编译的表达式：三地址字节码，操作数取自寄存器、常量池或变量。只含常量的子表达式在编译时折叠，
+    // 寄存器个数在编译时确定。语法与 evaluate_expression 相同，另外允许命名变量（字母或下划线开头）
+    struct CompiledExpression {
+        enum class Op : uint8_t { Neg, Add, Sub, Mul, Div, Sum, Max };
+        enum class Source : uint8_t { Register, Constant, Variable };
+        struct Operand {
+            Source source;
+            uint32_t index;
+        };
+        struct Instruction {
+            Op op;
+            uint32_t dst;  // 结果寄存器
+            Operand a, b;  // Sum/Max 时 a.index 为 arguments 中的起始下标，b.index 为参数个数
+        };
+
+        std::vector<Instruction> code;
+        std::vector<Operand> arguments;
+        std::vector<BigInteger> constants;
+        std::vector<std::string> variables; // 按首次出现的顺序，bindings 按同样的顺序给值
+        size_t registers = 0;
+        Operand result{};
+    };
+
+    CompiledExpression compile(const std::string& expr);
+    size_t variable_index(const CompiledExpression& compiled, const std::string& name);
+    // 求值时不做任何解析和字符串处理；寄存器在线程内复用，稳定后加减法与小乘数不再分配内存
+    BigInteger evaluate(const CompiledExpression& compiled, const std::vector<BigInteger>& bindings = {});
+
+    // 批量求值的单项结果：ok 为假时 error 是该项的异常信息，value 为 0
+    struct BatchResult {
+        bool ok = false;
+        BigInteger value = from_longlong(0);
+        std::string error;
+    };
+    // 在线程池上并行求值，结果与输入一一对应；单项出错只记录在该项中，不影响其余各项
+    std::vector<BatchResult> evaluate_batch(const std::vector<std::string>& exprs);
+    // 逐行读入表达式，每 block 行并行求值一次，按输入顺序逐行写出结果；出错的行写 "error: ..."，空行原样保留
+    void evaluate_stream(std::istream& in, std::ostream& out, size_t block = 4096);
 }
 
@@ -0,0 +1,68 @@
+#include <BigInteger/biginteger.h>
+
+#include <atomic>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 每个线程从共享计数器领取下一段下标，耗时不均的表达式也能摊开
+        const size_t BATCH_GRAIN = 16;
+
+        template <class Fn>
+        void for_each_index(size_t n, Fn fn) {
+            std::atomic<size_t> next{0};
+            const size_t workers = std::min(thread_count(), (n + BATCH_GRAIN - 1) / BATCH_GRAIN);
+            parallel_for(0, workers, 1, [&](size_t lo, size_t hi) {
+                for (size_t w = lo; w < hi; ++w) {
+                    for (;;) {
+                        const size_t begin = next.fetch_add(BATCH_GRAIN);
+                        if (begin >= n) break;
+                        for (size_t i = begin; i < std::min(n, begin + BATCH_GRAIN); ++i) fn(i);
+                    }
+                }
+            });
+        }
+
+        bool is_blank(const std::string& s) {
+            return std::all_of(s.begin(), s.end(), [](char c) { return isspace((unsigned char)c); });
+        }
+    }
+
+    std::vector<BatchResult> evaluate_batch(const std::vector<std::string>& exprs) {
+        std::vector<BatchResult> results(exprs.size());
+        for_each_index(exprs.size(), [&](size_t i) {
+            try {
+                results[i].value = evaluate_expression(exprs[i]);
+                results[i].ok = true;
+            } catch (const std::exception& e) {
+                results[i].error = e.what();
+            }
+        });
+        return results;
+    }
+
+    void evaluate_stream(std::istream& in, std::ostream& out, size_t block) {
+        std::vector<std::string> lines;
+        std::vector<std::string> outputs;
+        block = std::max<size_t>(block, 1);
+        for (;;) {
+            lines.clear();
+            std::string line;
+            while (lines.size() < block && std::getline(in, line)) lines.push_back(std::move(line));
+            if (lines.empty()) return;
+
+            // 结果在工作线程里直接转成十进制，主线程只负责按顺序写出
+            outputs.assign(lines.size(), std::string());
+            for_each_index(lines.size(), [&](size_t i) {
+                if (is_blank(lines[i])) return;
+                try {
+                    outputs[i] = to_string(evaluate_expression(lines[i]));
+                } catch (const std::exception& e) {
+                    outputs[i] = std::string("error: ") + e.what();
+                }
+            });
+            for (const auto& s : outputs) out << s << '\n';
+        }
+    }
+}
@@ -1,4 +1,5 @@
-#include <Biginteger/biginteger.h>
+#include <BigInteger/biginteger.h>
+#include <cstring>
 
 namespace Biginteger{
 
@@ -6,80 +7,6 @@ namespace Biginteger{
         num.digits.resize(target_len, 0);
     }
 
-    void add_with_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b) {
-        size_t max_len = std::max(a.digits.size(), b.digits.size());
-        result.digits.resize(max_len + 1, 0);
-        
-        size_t i = 0;
-        __m512i carry = _mm512_setzero_si512();
-        
-        for (; i + 16 <= max_len; i += 16) {
-            __m512i va = _mm512_loadu_si512((__m512i*)&a.digits[i]);
-            __m512i vb = _mm512_loadu_si512((__m512i*)&b.digits[i]);
-            
-            __m512i sum = _mm512_add_epi32(va, vb);
-            sum = _mm512_add_epi32(sum, carry);
-            
-            __mmask16 carry_mask = _mm512_cmpgt_epi32_mask(sum, _mm512_set1_epi32(9));
-            sum = _mm512_mask_sub_epi32(sum, carry_mask, sum, _mm512_set1_epi32(10));
-            carry = _mm512_maskz_set1_epi32(carry_mask, 1);
-            
-            _mm512_storeu_si512((__m512i*)&result.digits[i], sum);
-        }
-        
-        int carry_scalar = _mm512_mask_reduce_add_epi32(1, carry);
-        for (; i < max_len; ++i) {
-            int sum = carry_scalar;
-            if (i < a.digits.size()) sum += a.digits[i];
-            if (i < b.digits.size()) sum += b.digits[i];
-            
-            carry_scalar = sum / 10;
-            result.digits[i] = sum % 10;
-        }
-        
-        if (carry_scalar)
-            result.digits[max_len] = carry_scalar;
-        
-        remove_leading_zeros(result);
-    }
-
-    void multiply_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b) {
-        result.digits.resize(a.digits.size() + b.digits.size(), 0);
-        
-        for (size_t i = 0; i < a.digits.size(); ++i) {
-            __m512i carry = _mm512_setzero_si512();
-            __m512i va = _mm512_set1_epi32(a.digits[i]);
-            
-            size_t j = 0;
-            for (; j + 16 <= b.digits.size(); j += 16) {
-                __m512i vb = _mm512_loadu_si512((__m512i*)&b.digits[j]);
-                __m512i res = _mm512_loadu_si512((__m512i*)&result.digits[i + j]);
-                
-                __m512i product = _mm512_mullo_epi32(va, vb);
-                res = _mm512_add_epi32(res, product);
-                res = _mm512_add_epi32(res, carry);
-                
-                __mmask16 carry_mask = _mm512_cmpgt_epi32_mask(res, _mm512_set1_epi32(9));
-                res = _mm512_mask_sub_epi32(res, carry_mask, res, _mm512_set1_epi32(10));
-                carry = _mm512_maskz_set1_epi32(carry_mask, 1);
-                
-                _mm512_storeu_si512((__m512i*)&result.digits[i + j], res);
-            }
-            
-            int carry_scalar = _mm512_mask_reduce_add_epi32(1, carry);
-            for (; j < b.digits.size(); ++j) {
-                int product = a.digits[i] * b.digits[j] + result.digits[i + j] + carry_scalar;
-                carry_scalar = product / 10;
-                result.digits[i + j] = product % 10;
-            }
-            
-            if (carry_scalar)
-                result.digits[i + b.digits.size()] = carry_scalar;
-        }
-        
-        remove_leading_zeros(result);
-    }
-
     BigInteger get_lower(const BigInteger& num, size_t n) {
         BigInteger result;
         result.digits.resize(std::min(n, num.digits.size()));
@@ -100,8 +27,36 @@ namespace Biginteger{
         return result;
     }
 
+    BigInteger lower(const BigInteger& num, size_t n) {
+        BigInteger result = get_lower(num, n);
+        remove_leading_zeros(result);
+        return result;
+    }
+
+    BigInteger upper(const BigInteger& num, size_t n) {
+        BigInteger result = get_upper(num, n);
+        remove_leading_zeros(result);
+        return result;
+    }
+
+    BigInteger power_of_base(size_t n) {
+        BigInteger result;
+        result.digits.assign(n + 1, 0);
+        result.digits[n] = 1;
+        return result;
+    }
+
+    bool is_zero(const BigInteger& num) {
+        return num.digits.size() == 1 && num.digits[0] == 0;
+    }
+
+    size_t trimmed_length(const limb_t* x, size_t n) {
+        while (n > 0 && x[n - 1] == 0) --n;
+        return n;
+    }
+
     BigInteger shift_left(const BigInteger& num, size_t shift) {
-        if (num.digits.size() == 1 && num.digits[0] == 0)
+        if (is_zero(num))
             return num;
 
         BigInteger result;
@@ -110,69 +65,127 @@ namespace Biginteger{
         return result;
     }
 
-    BigInteger karatsuba(const BigInteger& a, const BigInteger& b) {
-        const size_t len = std::max(a.digits.size(), b.digits.size());
-        
-        if (len < KARATSUBA_THRESHOLD)
-            return multiply_abs(a, b);
-
-        // 补零对齐
-        BigInteger a_copy = a;
-        BigInteger b_copy = b;
-        pad_zeros(a_copy, len);
-        pad_zeros(b_copy, len);
+    namespace {
+
+        // Karatsuba 在 limb 区间上原地递归：要求 na >= nb > na / 2，out 有 na + nb 个 limb。
+        // z0、z2 直接写进 out 的低、高两段，只有两个和与 z1 放在 scratch 里，子问题的临时空间紧随其后
+        size_t karatsuba_scratch(size_t na, size_t nb) {
+            const size_t m = na / 2, h = na - m;
+            const size_t lb = std::max(m, nb - m) + 1;
+            const size_t own = (h + 1) + lb + (h + 1 + lb);
+            const size_t s0 = mul_scratch(m, m), s2 = mul_scratch(h, nb - m), s1 = mul_scratch(h + 1, lb);
+            // 并行时三个子乘积同时运行，各占一段
+            if (m >= thresholds().parallel) return own + s0 + s1 + s2;
+            return own + std::max({s0, s1, s2});
+        }
+
+        void karatsuba_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch) {
+            BIGINTEGER_STAT(Karatsuba, nb);
+            const size_t m = na / 2, h = na - m;
+            const size_t nb_high = nb - m;
+            const size_t lb = std::max(m, nb_high) + 1;
+            const size_t lz = h + 1 + lb;
+
+            limb_t* a_sum = scratch;
+            limb_t* b_sum = a_sum + (h + 1);
+            limb_t* z1 = b_sum + lb;
+            limb_t* rest = z1 + lz;
+
+            a_sum[h] = add_limbs(a_sum, a + m, h, a, m);
+            if (nb_high >= m) b_sum[lb - 1] = add_limbs(b_sum, b + m, nb_high, b, m);
+            else b_sum[lb - 1] = add_limbs(b_sum, b, m, b + m, nb_high);
+
+            // 三个子乘积写入互不重叠的区域，规模足够大时并行计算
+            if (m >= thresholds().parallel) {
+                limb_t* s0 = rest;
+                limb_t* s2 = s0 + mul_scratch(m, m);
+                limb_t* s1 = s2 + mul_scratch(h, nb_high);
+                parallel_invoke({
+                    [=] { mul_limbs(out, a, m, b, m, s0); },
+                    [=] { mul_limbs(out + 2 * m, a + m, h, b + m, nb_high, s2); },
+                    [=] { mul_limbs(z1, a_sum, h + 1, b_sum, lb, s1); },
+                }, m);
+            } else {
+                mul_limbs(out, a, m, b, m, rest);
+                mul_limbs(out + 2 * m, a + m, h, b + m, nb_high, rest);
+                mul_limbs(z1, a_sum, h + 1, b_sum, lb, rest);
+            }
 
-        size_t m = len / 2;
-        size_t m2 = len - m;
+            // z1 = (a0 + a1)(b0 + b1) - z0 - z2，再加到 out 的中段
+            sub_limbs(z1, z1, lz, out, 2 * m);
+            sub_limbs(z1, z1, lz, out + 2 * m, na + nb - 2 * m);
+            add_limbs(out + m, out + m, na + nb - m, z1, trimmed_length(z1, lz));
+        }
+    }
+
+    size_t mul_scratch(size_t na, size_t nb) {
+        if (na < nb) std::swap(na, nb);
+        const Thresholds& t = thresholds();
+        if (nb < t.karatsuba) return 0;
+        // 分段时一段的乘积加上它自己的临时空间；最后一段可能更短
+        if (2 * nb <= na) return 2 * nb + std::max(mul_scratch(nb, nb), mul_scratch(nb, na % nb));
+        if (nb >= t.fft) return 0;
+        if (nb < t.toom3) return karatsuba_scratch(na, nb);
+        if (nb < t.toom4) return toom3_scratch(na, nb);
+        return toom4_scratch(na, nb);
+    }
+
+    // 区间上的乘法阶梯：竖式、Karatsuba 与 Toom 在原地完成，FFT/NTT 直接写进 out
+    void mul_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch) {
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        const Thresholds& t = thresholds();
+        if (nb < t.karatsuba) {
+            multiply_limbs(out, a, na, b, nb);
+        } else if (2 * nb <= na) {
+            // 长度悬殊时把长的切成与短的等长的段，段积写在 scratch 里再原地加到 out 的对应位置。
+            // 前几段之和小于 BASE^(i+nb)，加第 i 段时进位不会越过 i + c + nb
+            limb_t* piece = scratch;
+            limb_t* rest = scratch + 2 * nb;
+            std::fill(out, out + na + nb, 0);
+            for (size_t i = 0; i < na; i += nb) {
+                const size_t c = std::min(nb, na - i);
+                mul_limbs(piece, b, nb, a + i, c, rest);
+                add_limbs(out + i, out + i, c + nb, piece, c + nb);
+            }
+        } else if (nb >= t.fft) {
+            if (na + nb < std::min(t.ntt, NTT_THRESHOLD)) fft_limbs(out, a, na, b, nb);
+            else ntt_limbs(out, a, na, b, nb);
+        } else if (nb < t.toom3) {
+            karatsuba_limbs(out, a, na, b, nb, scratch);
+        } else if (nb < t.toom4) {
+            toom3_limbs(out, a, na, b, nb, scratch);
+        } else {
+            toom4_limbs(out, a, na, b, nb, scratch);
+        }
+    }
 
-        BigInteger a_low = get_lower(a_copy, m);
-        BigInteger a_high = get_upper(a_copy, m);
-        BigInteger b_low = get_lower(b_copy, m);
-        BigInteger b_high = get_upper(b_copy, m);
+    BigInteger karatsuba(const BigInteger& a, const BigInteger& b) {
+        const BigInteger& x = a.digits.size() >= b.digits.size() ? a : b;
+        const BigInteger& y = a.digits.size() >= b.digits.size() ? b : a;
+        const size_t na = x.digits.size(), nb = y.digits.size();
 
-        BigInteger z0 = karatsuba(a_low, b_low);
-        BigInteger z2 = karatsuba(a_high, b_high);
-        
-        BigInteger a_sum = a_low + a_high;
-        BigInteger b_sum = b_low + b_high;
-        BigInteger z1 = karatsuba(a_sum, b_sum) - z0 - z2;
+        if (na < thresholds().karatsuba)
+            return multiply_abs(a, b);
+        // 长度悬殊时由 multiply_dispatch 切成平衡的段
+        if (2 * nb <= na)
+            return multiply_dispatch(x, y);
 
-        // 合并结果
-        return shift_left(z2, 2*m) + shift_left(z1, m) + z0;
+        // 结果之外的临时空间一次从线程的 ScratchFrame 取出
+        ScratchFrame frame;
+        limb_t* scratch = frame.limbs(karatsuba_scratch(na, nb));
+        BigInteger result;
+        result.digits.resize(na + nb);
+        karatsuba_limbs(result.digits.data(), x.digits.data(), na, y.digits.data(), nb, scratch);
+        remove_leading_zeros(result);
+        return result;
     }
 
+    // 历史名字，与 karatsuba 相同
     BigInteger karatsuba_avx512(const BigInteger& a, const BigInteger& b) {
-        const size_t len = std::max(a.digits.size(), b.digits.size());
-        
-        if (len < KARATSUBA_THRESHOLD) {
-            BigInteger result;
-            multiply_avx512(result, a, b);
-            return result;
-        }
-        
-        BigInteger a_copy = a;
-        BigInteger b_copy = b;
-        pad_zeros(a_copy, len);
-        pad_zeros(b_copy, len);
-        
-        size_t m = len / 2;
-        size_t m2 = len - m;
-        
-        BigInteger a_low = get_lower(a_copy, m);
-        BigInteger a_high = get_upper(a_copy, m);
-        BigInteger b_low = get_lower(b_copy, m);
-        BigInteger b_high = get_upper(b_copy, m);
-        
-        BigInteger z0 = karatsuba_avx512(a_low, b_low);
-        BigInteger z2 = karatsuba_avx512(a_high, b_high);
-        
-        BigInteger a_sum, b_sum;
-        add_with_avx512(a_sum, a_low, a_high);
-        add_with_avx512(b_sum, b_low, b_high);
-        
-        BigInteger z1 = karatsuba_avx512(a_sum, b_sum) - z0 - z2;
-        
-        return shift_left(z2, 2*m) + shift_left(z1, m) + z0;
+        return karatsuba(a, b);
     }
 
     void remove_leading_zeros(BigInteger& num)
@@ -184,15 +197,46 @@ namespace Biginteger{
 
     int compare_abs(const BigInteger& a, const BigInteger& b) {
         if (a.digits.size() != b.digits.size())
-            return a.digits.size() - b.digits.size();
-        for (int i = a.digits.size()-1; i >= 0; --i) {
+            return a.digits.size() < b.digits.size() ? -1 : 1;
+        for (size_t i = a.digits.size(); i-- > 0;) {
             if (a.digits[i] != b.digits[i])
-                return a.digits[i] - b.digits[i];
+                return a.digits[i] < b.digits[i] ? -1 : 1;
         }
         return 0;
     }
 
+    namespace {
+
+        // "00" "01" ... "99"，每次处理两位十进制数
+        const char DIGIT_PAIRS[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        // 把 limb 写成恰好 width 位十进制数，写在 [end - width, end)
+        void write_limb(char* end, limb_t limb, int width) {
+            while (width >= 2) {
+                end -= 2;
+                std::memcpy(end, DIGIT_PAIRS + 2 * (limb % 100), 2);
+                limb /= 100;
+                width -= 2;
+            }
+            if (width) *--end = char('0' + limb);
+        }
+
+        int decimal_width(limb_t limb) {
+            int width = 1;
+            while (limb >= 10) {
+                limb /= 10;
+                ++width;
+            }
+            return width;
+        }
+    }
+
+    // 10^9 进制与十进制之间只是按 9 位分组，转换本身就是线性的，不需要分治的基数转换
     BigInteger from_string(const std::string& s) {
+        BIGINTEGER_STAT(FromString, s.size() / BASE_DIGITS);
         BigInteger num;
         if (s.empty()) throw std::invalid_argument("Empty string");
         
@@ -202,122 +246,236 @@ namespace Biginteger{
             start = 1;
         }
         
-        num.digits.resize(s.length() - start);
-        for (size_t i = start; i < s.length(); ++i) {
-            if (!isdigit(s[i])) throw std::invalid_argument("Invalid character");
-            num.digits[s.length()-1 - i] = s[i] - '0';  
+        if (start == s.length()) throw std::invalid_argument("Invalid character");
+
+        // 从低位开始每 9 个字符组成一个 limb
+        const char* text = s.data();
+        const size_t len = s.length() - start;
+        num.digits.resize((len + BASE_DIGITS - 1) / BASE_DIGITS);
+        size_t end = s.length();
+        bool valid = true;
+        for (size_t k = 0; k < num.digits.size(); ++k) {
+            size_t begin = end >= start + BASE_DIGITS ? end - BASE_DIGITS : start;
+            limb_t limb = 0;
+            for (size_t i = begin; i < end; ++i) {
+                unsigned digit = (unsigned char)text[i] - '0';
+                valid &= digit <= 9;
+                limb = limb * 10 + digit;
+            }
+            num.digits[k] = limb;
+            end = begin;
         }
+        if (!valid) throw std::invalid_argument("Invalid character");
         
         remove_leading_zeros(num);
+        if (is_zero(num)) num.is_negative = false;
         return num;
     }
 
     std::string to_string(const BigInteger& num) {
-        std::string s;
-        if (num.is_negative && !(num.digits.size() == 1 && num.digits[0] == 0))
-            s += '-';
-        for (auto it = num.digits.rbegin(); it != num.digits.rend(); ++it)
-            s += std::to_string(*it);
-        
-        // std::reverse(s.begin(), s.end());
+        BIGINTEGER_STAT(ToString, num.digits.size());
+        // 默认构造的 BigInteger 没有 limb，按 0 输出
+        if (num.digits.empty()) return "0";
+        const bool negative = num.is_negative && !is_zero(num);
+        const int top_width = decimal_width(num.digits.back());
+
+        // 一次分配好整个结果，从低位往高位填写；除最高位外每个 limb 补足 9 位
+        std::string s(negative + top_width + (num.digits.size() - 1) * BASE_DIGITS, '0');
+        char* end = &s[0] + s.size();
+        for (size_t i = 0; i + 1 < num.digits.size(); ++i) {
+            write_limb(end, num.digits[i], BASE_DIGITS);
+            end -= BASE_DIGITS;
+        }
+        write_limb(end, num.digits.back(), top_width);
+        if (negative) s[0] = '-';
         return s;
     }
 
+    std::ostream& operator<<(std::ostream& os, const BigInteger& num) {
+        return os << to_string(num);
+    }
+
+    namespace {
+        // out = |x| + |y|，要求 x 不短于 y；out 可以是 x 或 y 本身，容量足够时不分配
+        void add_abs_into(BigInteger& out, const BigInteger& x, const BigInteger& y) {
+            const size_t nx = x.digits.size();
+            const size_t ny = y.digits.size(); // out 是 y 时 resize 会改变 y 的长度，先记下
+            BIGINTEGER_STAT(Add, nx);
+            out.digits.resize(nx + 1); // 最多多出一个进位 limb
+            out.digits[nx] = add_limbs(out.digits.data(), x.digits.data(), nx, y.digits.data(), ny);
+            if (out.digits[nx] == 0) out.digits.pop_back();
+        }
+
+        // out = |x| - |y|，要求 |x| >= |y|；别名规则同 add_abs_into
+        void sub_abs_into(BigInteger& out, const BigInteger& x, const BigInteger& y) {
+            const size_t nx = x.digits.size();
+            const size_t ny = y.digits.size();
+            BIGINTEGER_STAT(Sub, nx);
+            out.digits.resize(nx);
+            sub_limbs(out.digits.data(), x.digits.data(), nx, y.digits.data(), ny);
+            remove_leading_zeros(out);
+        }
+
+        // out = a + (negative_b ? -|b| : |b|)，加减法共用，不复制操作数
+        void add_signed(BigInteger& out, const BigInteger& a, const BigInteger& b, bool negative_b) {
+            const bool negative_a = a.is_negative;
+            if (negative_a == negative_b) {
+                if (a.digits.size() >= b.digits.size()) add_abs_into(out, a, b);
+                else add_abs_into(out, b, a);
+                out.is_negative = negative_a;
+                return;
+            }
+
+            // 异号处理：转换为幅值相减，结果取幅值较大者的符号
+            int cmp = compare_abs(a, b);
+            if (cmp == 0) {  // 相等时结果为0
+                out.digits.assign(1, 0);
+                out.is_negative = false;
+                return;
+            }
+            if (cmp > 0) sub_abs_into(out, a, b);
+            else sub_abs_into(out, b, a);
+            out.is_negative = cmp > 0 ? negative_a : negative_b;
+        }
+    }
+
     BigInteger add_abs(const BigInteger& a, const BigInteger& b) {
         BigInteger result;
-        size_t max_len = std::max(a.digits.size(), b.digits.size());
-        result.digits.resize(max_len + 1, 0); // 预分配
-        
-        int carry = 0;
-        for (size_t i = 0; i < max_len || carry; ++i) {
-            int sum = carry;
-            if (i < a.digits.size()) sum += a.digits[i];
-            if (i < b.digits.size()) sum += b.digits[i];
-            
-            carry = sum / 10;
-            result.digits[i] = sum % 10; // 直接通过索引赋值
-        }
-        
-        remove_leading_zeros(result);
+        if (a.digits.size() >= b.digits.size()) add_abs_into(result, a, b);
+        else add_abs_into(result, b, a);
         return result;
     }
 
     BigInteger absolute(const BigInteger& num){
-        BigInteger result = num;
-        result.is_negative = false;
-        return result;
+        return absolute(BigInteger(num));
+    }
+
+    BigInteger absolute(BigInteger&& num){
+        num.is_negative = false;
+        return std::move(num);
     }
 
     BigInteger negate(const BigInteger& num){
-        BigInteger result = num;
-        if (!(result.digits.size() == 1 && result.digits[0] == 0)) {
-            result.is_negative = !result.is_negative;
+        return negate(BigInteger(num));
+    }
+
+    BigInteger negate(BigInteger&& num){
+        if (!is_zero(num)) {
+            num.is_negative = !num.is_negative;
         }
-        return result;
+        return std::move(num);
     }
 
     // abs(a) must >= abs(b)
     BigInteger sub_abs(const BigInteger& a, const BigInteger& b) {
         BigInteger result;
-        int borrow = 0;
-
-        for (size_t i = 0; i < a.digits.size(); ++i) {
-            int sub = a.digits[i] - borrow;
-            borrow = 0;
-            
-            if (i < b.digits.size()) sub -= b.digits[i];
-            
-            if (sub < 0) {
-                sub += 10;
-                borrow = 1;
-            }
-            result.digits.push_back(sub);
-        }
-        
-        remove_leading_zeros(result);
+        sub_abs_into(result, a, b);
         return result;
     }
 
     BigInteger from_longlong(long long x) {
         BigInteger num;
+        unsigned long long ux = x;
         if (x < 0) {
             num.is_negative = true;
-            x = -x;
+            ux = 0ULL - ux;
         }
         do {
-            num.digits.push_back(x % 10);
-            x /= 10;
-        } while (x > 0);
+            num.digits.push_back(ux % BASE);
+            ux /= BASE;
+        } while (ux > 0);
         return num;
     }
 
-    BigInteger operator+(const BigInteger& a, const BigInteger& b) {
-        if (a.is_negative == b.is_negative) {
-            BigInteger result = add_abs(a, b);
-            result.is_negative = a.is_negative;
-            return result;
-        }
-        
-        // 异号处理：转换为减法
-        const BigInteger& pos = a.is_negative ? b : a;
-        const BigInteger& neg = a.is_negative ? a : b;
-        
-        int cmp = compare_abs(a, b);
-        if (cmp == 0) return from_longlong(0);  // 相等时返回0
-        
-        if (cmp > 0) {
-            BigInteger result = sub_abs(pos, absolute(neg));
-            result.is_negative = false;
-            return result;
-        } else {
-            BigInteger result = sub_abs(absolute(neg), pos);
-            result.is_negative = true;
-            return result;
+    void add(BigInteger& out, const BigInteger& a, const BigInteger& b) {
+        add_signed(out, a, b, b.is_negative);
+    }
+
+    void sub(BigInteger& out, const BigInteger& a, const BigInteger& b) {
+        add_signed(out, a, b, !b.is_negative);  // a - b = a + (-b)
+    }
+
+    void mul(BigInteger& out, const BigInteger& a, const BigInteger& b) {
+        // 单 limb 乘数在 out 原有的缓冲区里原地完成；其余情况由乘法算法本身分配
+        const BigInteger& x = b.digits.size() == 1 ? a : b;
+        const BigInteger& y = b.digits.size() == 1 ? b : a;
+        if (y.digits.size() == 1) {
+            const int64_t k = y.is_negative ? -(int64_t)y.digits[0] : (int64_t)y.digits[0];
+            if (&out != &x) {
+                out.digits.assign(x.digits.begin(), x.digits.end());
+                out.is_negative = x.is_negative;
+            }
+            mul_small(out, k);
+            return;
         }
+        out = a * b;
+    }
+
+    BigInteger operator+(const BigInteger& a, const BigInteger& b) {
+        BigInteger result;
+        add(result, a, b);
+        return result;
+    }
+
+    BigInteger operator+(BigInteger&& a, const BigInteger& b) {
+        a += b;
+        return std::move(a);
+    }
+
+    BigInteger operator+(const BigInteger& a, BigInteger&& b) {
+        add(b, a, b);
+        return std::move(b);
+    }
+
+    BigInteger operator+(BigInteger&& a, BigInteger&& b) {
+        a += b;
+        return std::move(a);
     }
 
     BigInteger operator-(const BigInteger& a, const BigInteger& b) {
-        return a + negate(b);  // a - b = a + (-b)
+        BigInteger result;
+        sub(result, a, b);
+        return result;
+    }
+
+    BigInteger operator-(BigInteger&& a, const BigInteger& b) {
+        a -= b;
+        return std::move(a);
+    }
+
+    BigInteger operator-(const BigInteger& a, BigInteger&& b) {
+        sub(b, a, b);
+        return std::move(b);
+    }
+
+    BigInteger operator-(BigInteger&& a, BigInteger&& b) {
+        a -= b;
+        return std::move(a);
+    }
+
+    BigInteger& operator+=(BigInteger& a, const BigInteger& b) {
+        add(a, a, b);
+        return a;
+    }
+
+    BigInteger& operator-=(BigInteger& a, const BigInteger& b) {
+        sub(a, a, b);
+        return a;
+    }
+
+    BigInteger& operator*=(BigInteger& a, const BigInteger& b) {
+        mul(a, a, b);
+        return a;
+    }
+
+    BigInteger& operator/=(BigInteger& a, const BigInteger& b) {
+        a = a / b;
+        return a;
+    }
+
+    BigInteger& operator%=(BigInteger& a, const BigInteger& b) {
+        a = a % b;
+        return a;
     }
 
     bool operator<(const BigInteger& a, const BigInteger& b) {
@@ -330,136 +488,83 @@ namespace Biginteger{
         return compare_abs(a, b) < 0;
     }
 
+    bool operator>(const BigInteger& a, const BigInteger& b) {
+        return b < a;
+    }
+
+    bool operator<=(const BigInteger& a, const BigInteger& b) {
+        return !(b < a);
+    }
+
+    bool operator>=(const BigInteger& a, const BigInteger& b) {
+        return !(a < b);
+    }
+
     bool operator==(const BigInteger& a, const BigInteger& b) {
         return a.is_negative == b.is_negative && a.digits == b.digits;
     }
 
+    // 竖式乘法：逐行累加由 simd_level() 选择的内核完成
     BigInteger multiply_abs(const BigInteger& a, const BigInteger &b){
         BigInteger result;
-        result.digits.resize(a.digits.size() + b.digits.size(), 0);
-
-        for (size_t i = 0; i < a.digits.size(); ++i) {
-            int carry = 0;
-            for (size_t j = 0; j < b.digits.size() || carry; ++j) {
-                long long product = result.digits[i + j] + a.digits[i] * (j < b.digits.size() ? b.digits[j] : 0) + carry;
-                result.digits[i + j] = product % 10;
-                carry = product / 10;
-            }
-        }
-
-        remove_leading_zeros(result);
+        multiply_avx512(result, a, b);
         return result;
     }
 
-    BigInteger operator*(const BigInteger& a, const BigInteger& b) {
-        if ((a.digits.size() == 1 && a.digits[0] == 0) ||
-            (b.digits.size() == 1 && b.digits[0] == 0)) {
-            return from_longlong(0);
-        }
-
-        BigInteger result;
-        const size_t n = a.digits.size() + b.digits.size();
-        // if (a.digits.size() < KARATSUBA_THRESHOLD || 
-        //     b.digits.size() < KARATSUBA_THRESHOLD) {
-        //     result = multiply_abs(a, b);
-        // } else if(a.digits.size() >= FFT_THRESHOLD &&
-        //             b.digits.size() >= FFT_THRESHOLD){
-        //     result = FFT_multiply(a, b);
-        // }else{
-        //     // result = karatsuba(a, b);
-        //     result = FFT_multiply(a, b);
-        // }
-        if (n < FFT_THRESHOLD) {
-            result = multiply_abs(a, b);
-        }else {
-            result = FFT_multiply(a, b);
-        }
+    // 乘法阶梯：竖式 → Karatsuba → Toom-3 → Toom-4 → FFT → NTT，只处理绝对值
+    BigInteger multiply_dispatch(const BigInteger& a, const BigInteger& b) {
+        const BigInteger& x = a.digits.size() >= b.digits.size() ? a : b;
+        const BigInteger& y = a.digits.size() >= b.digits.size() ? b : a;
+        const size_t n = y.digits.size();
+        const Thresholds& t = thresholds();
 
+        if (n < t.karatsuba)
+            return multiply_abs(x, y);
 
-        result.is_negative = a.is_negative != b.is_negative;
-        remove_leading_zeros(result);
-        
-        if (result.digits.size() == 1 && result.digits[0] == 0) {
-            result.is_negative = false;
+        // 长度悬殊时由 mul_limbs 逐段做平衡乘法，段积与各段的临时空间一次从 ScratchFrame 取出
+        if (x.digits.size() >= 2 * n) {
+            const size_t nx = x.digits.size();
+            ScratchFrame frame;
+            limb_t* scratch = frame.limbs(mul_scratch(nx, n));
+            BigInteger result;
+            result.digits.resize(nx + n);
+            mul_limbs(result.digits.data(), x.digits.data(), nx, y.digits.data(), n, scratch);
+            remove_leading_zeros(result);
+            return result;
         }
-        return result;
-    }
 
-    void fft(std::vector<std::complex<double>>& a, bool inv){
-        const int n = a.size();
-        if (n == 1) {
-            return;
+        if (n >= t.fft) {
+            if (x.digits.size() + n < std::min(t.ntt, NTT_THRESHOLD))
+                return absolute(FFT_multiply(x, y));
+            return absolute(NTT_multiply(x, y));
         }
 
-        std::vector<std::complex<double>> a0(n / 2), a1(n / 2);
-        for (int i = 0, j = 0; i < n; i += 2, j++) {
-            a0[j] = a[i];
-            a1[j] = a[i + 1];
-        }
-        fft(a0, inv);
-        fft(a1, inv);
-        
-        //FFT
-        const double angle = 2 * PI / n * (inv ? -1 : 1);
-        std::complex<double> w(1.0, 0.0);
-        const std::complex<double> wn(cos(angle), sin(angle));
-        for (int i = 0; i < n / 2; i++) {
-            a[i] = a0[i] + w * a1[i];
-            a[i + n / 2] = a0[i] - w * a1[i];
-            w *= wn;
-        }
+        BigInteger result;
+        if (n < t.toom3)
+            result = karatsuba(x, y);
+        else if (n < t.toom4)
+            result = toom3(x, y);
+        else
+            result = toom4(x, y);
+        result.is_negative = false;
+        return result;
     }
 
-    BigInteger FFT_multiply(BigInteger a, BigInteger b){
-        if ((a.digits.size() == 1 && a.digits[0] == 0) ||
-            (b.digits.size() == 1 && b.digits[0] == 0)) {
+    BigInteger operator*(const BigInteger& a, const BigInteger& b) {
+        if (is_zero(a) || is_zero(b)) {
             return from_longlong(0);
         }
+        // 单 limb 操作数走线性的小整数乘法
+        if (b.digits.size() == 1)
+            return a * (b.is_negative ? -(int64_t)b.digits[0] : (int64_t)b.digits[0]);
+        if (a.digits.size() == 1)
+            return b * (a.is_negative ? -(int64_t)a.digits[0] : (int64_t)a.digits[0]);
 
-        int n = 1;
-        while (n < a.digits.size() + b.digits.size()) {
-            n *= 2;
-        }
-
-        a.digits.resize(n); b.digits.resize(n);
-        std::vector<std::complex<double>> c(n), d(n);
-
-        for (int i = 0; i < n; i++) {
-            c[i] = std::complex<double>(a.digits[i], 0);
-            d[i] = std::complex<double>(b.digits[i], 0);
-        }
-
-        fft(c, false), fft(d, false);
-        for (int i = 0; i < n; i++) {
-            c[i] *= d[i];
-        }
-        
-        fft(c, true);
-        
-        std::vector<int> res(n);
-        int carry = 0;
-        for (int i = 0; i < n; i++) {
-            res[i] = (int)(c[i].real() / n + 0.5);
-            res[i] += carry;
-            carry = res[i] / 10;
-            res[i] %= 10;
-        }
-        
-        // int carry = 0;
-        // for (int i = 0; i < n; i++) {
-        //     res[i] += carry;
-        //     carry = res[i] / 10;
-        //     res[i] %= 10;
-        // }
+        BigInteger result = multiply_dispatch(a, b);
+        result.is_negative = a.is_negative != b.is_negative;
+        remove_leading_zeros(result);
         
-        while (res.size() > 1 && res.back() == 0) {
-            res.pop_back();
-        }
-        BigInteger result;
-        result.digits = res;
-        if (a.is_negative + b.is_negative == 1){
-            result.is_negative = true;
-        }else{
+        if (is_zero(result)) {
             result.is_negative = false;
         }
         return result;
@@ -517,50 +622,14 @@ namespace Biginteger{
             return BigIntegerZero;
         }
 
-        std::vector<int> a_digits_high(a.digits.rbegin(), a.digits.rend());
-        std::vector<int> b_digits_high(b.digits.rbegin(), b.digits.rend());
-
-        std::vector<int> quotient_digits_high;
-        remainder = BigIntegerZero;
-
-        for (int digit : a_digits_high) {
-            remainder.digits.insert(remainder.digits.begin(), 0); // 乘以10
-            remainder.digits[0] = digit; // 加当前位
-            remove_leading_zeros(remainder);
-
-            int q = 0;
-            if (compare_abs(remainder, b) >= 0) {
-                int low = 0, high = 9;
-                while (low <= high) {
-                    int mid = (low + high) / 2;
-                    BigInteger product = multiply_abs(b, from_longlong(mid));
-                    if (compare_abs(product, remainder) <= 0) {
-                        q = mid;
-                        low = mid + 1;
-                    } else {
-                        high = mid - 1;
-                    }
-                }
-                BigInteger product = multiply_abs(b, from_longlong(q));
-                remainder = sub_abs(remainder, product);
-            }
-            quotient_digits_high.push_back(q);
-        }
+        BigInteger quotient = divide_abs(a, b, remainder);
 
-        std::ranges::reverse(quotient_digits_high);
-        // while (quotient_digits_high.size() > 1 && quotient_digits_high.back() == 0) {
-        //     quotient_digits_high.pop_back();
-        // }
-        // reverse(quotient_digits_high.begin(), quotient_digits_high.end());
-        
-        BigInteger quotient;
-        quotient.digits = quotient_digits_high;
         quotient.is_negative = quotient_negative;
         remove_leading_zeros(quotient);
 
         // 设置余数的符号
-        remainder.is_negative = dividend.is_negative;
         remove_leading_zeros(remainder);
+        remainder.is_negative = dividend.is_negative && !is_zero(remainder);
 
         return quotient;
     }
@@ -576,51 +645,13 @@ namespace Biginteger{
     }
 
     BigInteger multiply_by_10(const BigInteger& num) {
-        BigInteger result = num;
-        result.digits.insert(result.digits.begin(), 0);
-        remove_leading_zeros(result);
-        return result;
+        return num * 10;
     }
 
     std::string divide_decimal(const BigInteger& a, const BigInteger& b, int precision) {
-        if (compare_abs(b, BigIntegerZero) == 0) {
-            throw std::invalid_argument("Division by zero");
-        }
-
-        bool result_negative = a.is_negative != b.is_negative;
-
-        BigInteger a_abs = absolute(a);
-        BigInteger b_abs = absolute(b);
-
-        BigInteger quotient, remainder;
-        quotient = divide(a_abs, b_abs, remainder);
-
         std::string result;
-
-        if (result_negative && !(quotient.digits.size() == 1 && quotient.digits[0] == 0 && remainder.digits.size() == 1 && remainder.digits[0] == 0)) {
-            result += "-";
-        }
-
-        result += to_string(quotient);
-
-        if (!(remainder.digits.size() == 1 && remainder.digits[0] == 0) && precision > 0) {
-            result += ".";
-
-            BigInteger remainder_abs = absolute(remainder);
-
-            for (int i = 0; i < precision; ++i) {
-                remainder_abs = multiply_by_10(remainder_abs);
-                BigInteger temp_quotient, temp_remainder;
-                temp_quotient = divide(remainder_abs, b_abs, temp_remainder);
-                result += to_string(temp_quotient);
-                remainder_abs = temp_remainder;
-
-                if (remainder_abs.digits.size() == 1 && remainder_abs.digits[0] == 0) {
-                    break;
-                }
-            }
-        }
-
+        divide_decimal_stream(a, b, precision > 0 ? (size_t)precision : 0,
+                              [&](std::string_view part) { result += part; });
         return result;
     }
     BigInteger integer_divide(const BigInteger& a, const BigInteger& b) {
@@ -631,9 +662,15 @@ namespace Biginteger{
     // 求和函数
     BigInteger sum(const std::vector<BigInteger>& nums) {
         if (nums.empty()) return from_longlong(0);
-        BigInteger total = nums[0];
+        // 和的长度不超过最长的加数再多两个 limb（加数少于 10^9 个），一次预留后原地累加
+        size_t longest = 0;
+        for (const auto& num : nums) longest = std::max(longest, num.digits.size());
+        BigInteger total;
+        total.digits.reserve(longest + 2);
+        total.digits.assign(nums[0].digits.begin(), nums[0].digits.end());
+        total.is_negative = nums[0].is_negative;
         for (size_t i = 1; i < nums.size(); ++i) {
-            total = total + nums[i];
+            total += nums[i];
         }
         return total;
     }
@@ -682,7 +719,10 @@ namespace Biginteger{
             if (tokens[index] != ")") throw std::invalid_argument("Expected ')'");
             ++index;
             return val;
-        } else if (isdigit(tokens[index][0]) || tokens[index][0] == '-') { // 数字
+        } else if (tokens[index] == "-") { // 一元负号
+            ++index;
+            return negate(parse_primary(tokens, index));
+        } else if (isdigit(tokens[index][0])) { // 数字
             return from_string(tokens[index++]);
         } else if (isalpha(tokens[index][0])) { // 函数调用
             std::string func_name = tokens[index++];
@@ -701,9 +741,9 @@ namespace Biginteger{
                 ++index;
                 auto right = parse_primary(tokens, index);
                 if (op == "*") {
-                    left = left * right;
+                    left *= right;
                 } else if (op == "/") {
-                    left = divide_decimal(left, right, 10); // 默认保留10位小数
+                    left /= right; // 结果为整数，小数结果请用 divide_decimal
                 } else if (op == "//") {
                     left = integer_divide(left, right);
                 }
@@ -722,7 +762,8 @@ namespace Biginteger{
             if (op == "+" || op == "-") {
                 ++index;
                 auto right = parse_term(tokens, index);
-                left = (op == "+") ? (left + right) : (left - right);
+                if (op == "+") left += right;
+                else left -= right;
             } else {
                 break;
             }
@@ -735,36 +776,8 @@ namespace Biginteger{
         return parse_expr(tokens, index);
     }
 
-    // 公开的表达式解析接口
+    // 公开的表达式解析接口：编译后立即求值，不含变量
     BigInteger evaluate_expression(const std::string& expr) {
-        // 分词处理（支持复杂表达式）
-        std::vector<std::string> tokens;
-        std::string token;
-        for (char c : expr) {
-            if (isspace(c)) {
-                if (!token.empty()) {
-                    tokens.push_back(token);
-                    token.clear();
-                }
-            } else if (c == '(' || c == ')' || c == ',') {
-                if (!token.empty()) {
-                    tokens.push_back(token);
-                    token.clear();
-                }
-                tokens.push_back(std::string(1, c));
-            } else if (c == '+' || c == '-' || c == '*' || c == '/') {
-                if (!token.empty()) {
-                    tokens.push_back(token);
-                    token.clear();
-                }
-                tokens.push_back(std::string(1, c));
-            } else {
-                token += c;
-            }
-        }
-        if (!token.empty()) tokens.push_back(token);
-
-        size_t index = 0;
-        return eval(tokens, index);
+        return evaluate(compile(expr));
     }
-}
\ No newline at end of file
+}
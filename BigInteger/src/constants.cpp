@@ -0,0 +1,316 @@
+#include <BigInteger/biginteger.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace Biginteger{
+
+    namespace {
+
+        const char* const CONSTANT_NAMES[] = {"pi", "e", "log2", "sqrt2"};
+
+        // 多算的十进制位数。结果只差几个单位，末尾的保护位离进位边界足够远时截去即为正确的截断值，否则加倍重算
+        const size_t GUARD_DIGITS = 20;
+        const int64_t GUARD_MARGIN = 1000;
+
+        // 项数区间固定分成至多这么多段，与线程数无关，重跑时的分段与检查点中的记录一致
+        const size_t SPLIT_CHUNKS = 64;
+        const size_t MIN_CHUNK_TERMS = 256;
+
+        // Σ_{k<terms} a(k)/b(k) · ∏_{j<=k} p(j)/q(j)；has_b 为 false 时 b 恒为 1，B 不参与运算
+        struct Series {
+            uint64_t terms;
+            bool has_b;
+            double limbs_per_term; // Q、T 每项大约增长的 limb 数，用于判断子树是否值得并行
+            std::function<void(uint64_t k, BigInteger& p, BigInteger& q, BigInteger& a, BigInteger& b)> term;
+        };
+
+        // 区间 [a, b) 的部分和为 T / (B Q)，P、Q、B 为各自因子之积；最右侧的区间用不到 P，留空
+        struct Split {
+            BigInteger P, Q, B, T;
+        };
+
+        BigInteger power_of_ten(size_t n) {
+            static const int64_t small[BASE_DIGITS] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+            return shift_left(from_longlong(small[n % BASE_DIGITS]), n / BASE_DIGITS);
+        }
+
+        // 把相邻的两段合并：T = T_L B_R Q_R + B_L P_L T_R
+        Split merge(const Series& series, Split left, Split right, bool need_p) {
+            Split result;
+            BigInteger lt, rt;
+            parallel_invoke({
+                [&] { lt = left.T * right.Q; if (series.has_b) lt *= right.B; },
+                [&] { rt = left.P * right.T; if (series.has_b) rt *= left.B; },
+                [&] { result.Q = left.Q * right.Q; },
+                [&] { if (need_p) result.P = left.P * right.P; },
+            }, std::min(left.Q.digits.size(), right.Q.digits.size()));
+            if (series.has_b) result.B = left.B * right.B;
+            result.T = std::move(lt) + rt;
+            return result;
+        }
+
+        Split split(const Series& series, uint64_t a, uint64_t b, bool need_p) {
+            if (b - a == 1) {
+                Split leaf;
+                BigInteger coefficient;
+                series.term(a, leaf.P, leaf.Q, coefficient, leaf.B);
+                leaf.T = coefficient * leaf.P;
+                return leaf;
+            }
+            const uint64_t mid = a + (b - a) / 2;
+            Split left, right;
+            parallel_invoke({
+                [&] { left = split(series, a, mid, true); },
+                [&] { right = split(series, mid, b, need_p); },
+            }, (size_t)((mid - a) * series.limbs_per_term));
+            return merge(series, std::move(left), std::move(right), need_p);
+        }
+
+        void write_number(std::ostream& out, const BigInteger& num) {
+            const uint64_t size = num.digits.size();
+            out.put(num.is_negative ? 1 : 0);
+            out.write(reinterpret_cast<const char*>(&size), sizeof size);
+            out.write(reinterpret_cast<const char*>(num.digits.data()), size * sizeof(limb_t));
+        }
+
+        bool read_number(std::istream& in, BigInteger& num, uint64_t remaining) {
+            char sign;
+            uint64_t size;
+            if (!in.get(sign) || !in.read(reinterpret_cast<char*>(&size), sizeof size)) return false;
+            if (size > remaining / sizeof(limb_t)) return false; // 记录写了一半
+            num.digits.resize(size);
+            if (!in.read(reinterpret_cast<char*>(num.digits.data()), size * sizeof(limb_t))) return false;
+            num.is_negative = sign != 0;
+            return true;
+        }
+
+        // 检查点文件：头部是魔数、常数编号和要求的位数，之后每条记录是工作精度 precision 下第 series 个级数
+        // 在 [a, b) 上的 P、Q、B、T。保护位不够而加倍重算时工作精度变了，新记录接着追加，旧记录仍然保留，
+        // 中断后重跑时两轮都能跳过已完成的部分。每算完一段就追加并刷新；重跑时读回完整的记录，
+        // 截掉中断时写了一半的那条，头部不符时从头开始
+        class Checkpoint {
+        public:
+            Checkpoint(const std::string& path, uint64_t constant, uint64_t digits) : path(path) {
+                if (path.empty()) return;
+                const uint64_t header[2] = {constant, digits};
+                uint64_t valid = load(header);
+                if (valid == 0) {
+                    std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+                    fresh.write(MAGIC, sizeof MAGIC);
+                    fresh.write(reinterpret_cast<const char*>(header), sizeof header);
+                    if (!fresh) {
+                        throw std::invalid_argument("Cannot write checkpoint " + path);
+                    }
+                } else {
+                    std::filesystem::resize_file(path, valid);
+                }
+                out.open(path, std::ios::binary | std::ios::app);
+            }
+
+            const Split* find(uint64_t precision, uint64_t series, uint64_t a, uint64_t b) const {
+                auto it = saved.find({precision, series, a, b});
+                return it == saved.end() ? nullptr : &it->second;
+            }
+
+            void save(uint64_t precision, uint64_t series, uint64_t a, uint64_t b, const Split& s) {
+                if (path.empty()) return;
+                std::lock_guard<std::mutex> lock(mutex);
+                const uint64_t key[4] = {precision, series, a, b};
+                out.write(reinterpret_cast<const char*>(key), sizeof key);
+                for (const BigInteger* num : {&s.P, &s.Q, &s.B, &s.T}) write_number(out, *num);
+                out.flush();
+            }
+
+        private:
+            static constexpr char MAGIC[8] = {'B', 'I', 'G', 'C', 'K', 'P', 'T', '2'};
+
+            // 返回有效部分的字节数，文件不存在或头部不符时为 0
+            uint64_t load(const uint64_t (&header)[2]) {
+                std::ifstream in(path, std::ios::binary);
+                if (!in) return 0;
+                const uint64_t file_size = std::filesystem::file_size(path);
+                char magic[sizeof MAGIC];
+                uint64_t stored[2];
+                if (!in.read(magic, sizeof magic) || !std::equal(magic, magic + sizeof magic, MAGIC) ||
+                    !in.read(reinterpret_cast<char*>(stored), sizeof stored) ||
+                    stored[0] != header[0] || stored[1] != header[1]) return 0;
+
+                uint64_t valid = in.tellg();
+                while (true) {
+                    uint64_t key[4];
+                    Split s;
+                    if (!in.read(reinterpret_cast<char*>(key), sizeof key)) break;
+                    bool complete = true;
+                    for (BigInteger* num : {&s.P, &s.Q, &s.B, &s.T})
+                        complete = complete && read_number(in, *num, file_size - (uint64_t)in.tellg());
+                    if (!complete) break;
+                    saved[{key[0], key[1], key[2], key[3]}] = std::move(s);
+                    valid = in.tellg();
+                }
+                return valid;
+            }
+
+            std::string path;
+            std::mutex mutex;
+            std::ofstream out;
+            std::map<std::tuple<uint64_t, uint64_t, uint64_t, uint64_t>, Split> saved;
+        };
+
+        Split merge_chunks(const Series& series, std::vector<Split>& parts, size_t lo, size_t hi, bool need_p) {
+            if (hi - lo == 1) return std::move(parts[lo]);
+            const size_t mid = lo + (hi - lo) / 2;
+            Split left, right;
+            parallel_invoke({
+                [&] { left = merge_chunks(series, parts, lo, mid, true); },
+                [&] { right = merge_chunks(series, parts, mid, hi, need_p); },
+            }, (size_t)(series.terms / parts.size() * series.limbs_per_term));
+            return merge(series, std::move(left), std::move(right), need_p);
+        }
+
+        // 整个级数的 T、B、Q：各段并行求出并写入检查点，再按平衡二叉树合并
+        Split evaluate(const Series& series, uint64_t precision, uint64_t id, Checkpoint& checkpoint) {
+            BIGINTEGER_STAT(BinarySplitting, (size_t)(series.terms * series.limbs_per_term));
+            if (const Split* done = checkpoint.find(precision, id, 0, series.terms)) return *done;
+
+            const size_t chunks = (size_t)std::clamp<uint64_t>(series.terms / MIN_CHUNK_TERMS, 1, SPLIT_CHUNKS);
+            std::vector<Split> parts(chunks);
+            std::vector<std::function<void()>> tasks;
+            for (size_t i = 0; i < chunks; ++i) {
+                tasks.push_back([&, i] {
+                    const uint64_t a = series.terms * i / chunks, b = series.terms * (i + 1) / chunks;
+                    if (const Split* done = checkpoint.find(precision, id, a, b)) {
+                        parts[i] = *done;
+                        return;
+                    }
+                    parts[i] = split(series, a, b, i + 1 < chunks);
+                    checkpoint.save(precision, id, a, b, parts[i]);
+                });
+            }
+            parallel_invoke(tasks, (size_t)(series.terms / chunks * series.limbs_per_term));
+
+            Split total = merge_chunks(series, parts, 0, chunks, false);
+            if (chunks > 1) checkpoint.save(precision, id, 0, series.terms, total);
+            return total;
+        }
+
+        // scale · num / den 的整数部分，误差不超过几个单位。结果不超过 scale 的十倍，
+        // num、den 只需保留比 scale 多两个 limb 的相对精度，截去同样多的低位后再做除法
+        BigInteger scaled_quotient(const BigInteger& num, const BigInteger& den, const BigInteger& scale) {
+            const size_t keep = scale.digits.size() + 2;
+            const size_t shorter = std::min(num.digits.size(), den.digits.size());
+            const size_t shift = shorter > keep ? shorter - keep : 0;
+            return upper(num, shift) * scale / upper(den, shift);
+        }
+
+        // Chudnovsky：1/π = 12 Σ (-1)^k (6k)! (13591409 + 545140134k) / ((3k)! (k!)³ 640320^(3k+3/2))，每项约 14.18 位
+        Series chudnovsky(size_t precision) {
+            const int64_t C3_OVER_24 = 10939058860032000; // 640320³ / 24
+            return {precision / 14 + 2, false, 4.0,
+                    [=](uint64_t k, BigInteger& p, BigInteger& q, BigInteger& a, BigInteger&) {
+                        const int64_t n = (int64_t)k;
+                        a = from_longlong(13591409 + 545140134 * n);
+                        if (k == 0) {
+                            p = q = from_longlong(1);
+                            return;
+                        }
+                        p = from_longlong(-(6 * n - 5)) * (2 * n - 1) * (6 * n - 1);
+                        q = from_longlong(n * n) * n * C3_OVER_24;
+                    }};
+        }
+
+        // e = Σ 1/k!，项数取到 log10(N!) 超过工作精度
+        Series exp_one(size_t precision) {
+            uint64_t terms = 1;
+            for (double digits = 0; digits < precision + 2; ++terms) digits += std::log10((double)terms);
+            return {terms, false, std::log10((double)terms) / BASE_DIGITS + 0.1,
+                    [](uint64_t k, BigInteger& p, BigInteger& q, BigInteger& a, BigInteger&) {
+                        p = a = from_longlong(1);
+                        q = from_longlong(k == 0 ? 1 : (int64_t)k);
+                    }};
+        }
+
+        // atanh(1/x) = Σ 1/((2k+1) x^(2k+1))
+        Series atanh_inverse(size_t precision, int64_t x) {
+            const uint64_t terms = (uint64_t)(precision / (2 * std::log10((double)x))) + 2;
+            return {terms, true, 2 * std::log10((double)x) / BASE_DIGITS + 0.2,
+                    [=](uint64_t k, BigInteger& p, BigInteger& q, BigInteger& a, BigInteger& b) {
+                        p = a = from_longlong(1);
+                        q = from_longlong(k == 0 ? x : x * x);
+                        b = from_longlong(2 * (int64_t)k + 1);
+                    }};
+        }
+
+        // 常数乘以 10^precision 的近似整数，误差不超过几十个单位
+        BigInteger scaled_constant(Constant c, size_t precision, Checkpoint& checkpoint) {
+            const BigInteger scale = power_of_ten(precision);
+            switch (c) {
+            case Constant::Pi: {
+                // π = 426880 sqrt(10005) Q / T，开方与求和互不依赖
+                Split s;
+                BigInteger root;
+                parallel_invoke({
+                    [&] { s = evaluate(chudnovsky(precision), precision, 0, checkpoint); },
+                    [&] { root = isqrt(scale * scale * 10005) * 426880; },
+                }, scale.digits.size());
+                return scaled_quotient(s.Q, s.T, root);
+            }
+            case Constant::E: {
+                const Split s = evaluate(exp_one(precision), precision, 0, checkpoint);
+                return scaled_quotient(s.T, s.Q, scale);
+            }
+            case Constant::Log2: {
+                // log 2 = 18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749)
+                const int64_t xs[3] = {26, 4801, 8749}, weights[3] = {18, -2, 8};
+                BigInteger terms[3];
+                std::vector<std::function<void()>> tasks;
+                for (size_t i = 0; i < 3; ++i) {
+                    tasks.push_back([&, i] {
+                        const Split s = evaluate(atanh_inverse(precision, xs[i]), precision, i, checkpoint);
+                        terms[i] = scaled_quotient(s.T, s.B * s.Q, scale) * weights[i];
+                    });
+                }
+                parallel_invoke(tasks, scale.digits.size());
+                return terms[0] + terms[1] + terms[2];
+            }
+            case Constant::Sqrt2:
+                return isqrt(scale * scale * 2);
+            }
+            throw std::invalid_argument("Unknown constant");
+        }
+    }
+
+    const char* constant_name(Constant c) {
+        return CONSTANT_NAMES[(size_t)c];
+    }
+
+    Constant constant_from_name(const std::string& name) {
+        for (size_t i = 0; i < std::size(CONSTANT_NAMES); ++i)
+            if (name == CONSTANT_NAMES[i]) return (Constant)i;
+        throw std::invalid_argument("Unknown constant: " + name);
+    }
+
+    BigInteger compute_constant(Constant c, size_t digits, const std::string& path) {
+        Checkpoint checkpoint(path, (uint64_t)c, digits);
+        // 开方的结果本身就是精确的截断值
+        if (c == Constant::Sqrt2) return scaled_constant(c, digits, checkpoint);
+
+        for (size_t guard = GUARD_DIGITS;; guard *= 2) {
+            const BigInteger x = scaled_constant(c, digits + guard, checkpoint);
+            const BigInteger unit = power_of_ten(guard);
+            BigInteger remainder;
+            BigInteger result = divide(x, unit, remainder);
+            if (compare_small(remainder, GUARD_MARGIN) >= 0 && remainder + GUARD_MARGIN < unit) return result;
+        }
+    }
+
+    std::string constant_string(Constant c, size_t digits, const std::string& checkpoint) {
+        std::string s = to_string(compute_constant(c, digits, checkpoint));
+        if (s.size() <= digits) s.insert(0, digits + 1 - s.size(), '0');
+        if (digits > 0) s.insert(s.size() - digits, 1, '.');
+        return s;
+    }
+}
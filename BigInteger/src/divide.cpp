@@ -0,0 +1,390 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 倒数递归到该长度以下直接用 Knuth 算法 D
+        const size_t RECIPROCAL_BASECASE = 32;
+
+        // divide_decimal_stream 每块小数至少取这么多 limb（4608 位十进制）
+        const size_t DECIMAL_BLOCK_LIMBS = 512;
+
+        // 把 num 写成恰好 limbs * 9 位的十进制串，高位补零
+        void write_padded(std::string& out, const BigInteger& num, size_t limbs) {
+            out.assign(limbs * BASE_DIGITS, '0');
+            for (size_t i = 0; i < num.digits.size() && i < limbs; ++i) {
+                char* p = &out[(limbs - i) * BASE_DIGITS];
+                for (limb_t v = num.digits[i]; v; v /= 10) *--p = char('0' + v % 10);
+            }
+        }
+
+        // u[0..total) = a * d * BASE^shift，高位补零
+        void load_scaled(limb_t* u, size_t total, const BigInteger& a, limb_t d, size_t shift) {
+            std::fill(u, u + total, 0);
+            uint64_t carry = 0;
+            for (size_t i = 0; i < a.digits.size(); ++i) {
+                uint64_t cur = (uint64_t)a.digits[i] * d + carry;
+                u[shift + i] = (limb_t)(cur % BASE);
+                carry = cur / BASE;
+            }
+            if (shift + a.digits.size() < total) u[shift + a.digits.size()] = (limb_t)carry;
+        }
+
+        int compare_limbs(const limb_t* x, const limb_t* y, size_t n) {
+            for (size_t i = n; i-- > 0;)
+                if (x[i] != y[i]) return x[i] < y[i] ? -1 : 1;
+            return 0;
+        }
+
+        // z[0..nz) >= y[0..ny)，nz >= ny
+        bool at_least(const limb_t* z, size_t nz, const limb_t* y, size_t ny) {
+            for (size_t i = ny; i < nz; ++i)
+                if (z[i] != 0) return true;
+            return compare_limbs(z, y, ny) >= 0;
+        }
+
+        const limb_t ONE = 1;
+
+        // Knuth 算法 D 的主循环：v 有 n >= 2 个 limb 且已规格化，u 的高 n 个 limb 小于 v。
+        // 商的 nu - n 个 limb 写进 q，余数原地留在 u[0..n)，u 的其余部分归零
+        void knuth_limbs(limb_t* q, limb_t* u, size_t nu, const limb_t* v, size_t n) {
+            const uint64_t v1 = v[n - 1], v2 = v[n - 2];
+            for (size_t j = nu - n; j-- > 0;) {
+                uint64_t num = (uint64_t)u[j + n] * BASE + u[j + n - 1];
+                uint64_t qhat = num / v1, rhat = num % v1;
+                while (qhat >= BASE || qhat * v2 > rhat * BASE + u[j + n - 2]) {
+                    --qhat;
+                    rhat += v1;
+                    if (rhat >= BASE) break;
+                }
+
+                // u[j..j+n] -= qhat * v
+                int64_t borrow = 0;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t p = qhat * v[i] + carry;
+                    carry = p / BASE;
+                    int64_t t = (int64_t)u[i + j] - (int64_t)(p % BASE) - borrow;
+                    borrow = t < 0;
+                    u[i + j] = (limb_t)(t < 0 ? t + BASE : t);
+                }
+                int64_t t = (int64_t)u[j + n] - (int64_t)carry - borrow;
+                if (t < 0) {
+                    // 估商大了 1，加回一个除数
+                    u[j + n] = (limb_t)(t + BASE);
+                    --qhat;
+                    limb_t c = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        limb_t s = u[i + j] + v[i] + c;
+                        c = s >= BASE;
+                        u[i + j] = c ? s - BASE : s;
+                    }
+                    u[j + n] = (u[j + n] + c) % BASE;
+                } else {
+                    u[j + n] = (limb_t)t;
+                }
+                q[j] = (limb_t)qhat;
+            }
+        }
+
+        // Burnikel–Ziegler 在 limb 区间上原地递归。2n/1n：u 有 2n 个 limb 且 u < v * BASE^n，v 有 n 个 limb 且已规格化；
+        // 商写进 q[0..n)，余数留在 u[0..n)。3n/2n 的 q * v2 放在 scratch 里，子问题的临时空间紧随其后
+        bool bz_basecase(size_t n) {
+            return n % 2 != 0 || n < std::max<size_t>(thresholds().bz, 4);
+        }
+
+        size_t bz_scratch(size_t n) {
+            if (bz_basecase(n)) return 0;
+            const size_t k = n / 2;
+            return std::max(bz_scratch(k), 2 * k + mul_scratch(k, k));
+        }
+
+        void bz_div_3n2n(limb_t* q, limb_t* u, const limb_t* v, size_t k, limb_t* scratch);
+
+        void bz_div_2n1n(limb_t* q, limb_t* u, const limb_t* v, size_t n, limb_t* scratch) {
+            if (bz_basecase(n)) {
+                knuth_limbs(q, u, 2 * n, v, n);
+                return;
+            }
+            const size_t k = n / 2;
+            bz_div_3n2n(q + k, u + k, v, k, scratch);
+            bz_div_3n2n(q, u, v, k, scratch);
+        }
+
+        // 3n/2n：u 有 3k 个 limb 且 u < v * BASE^k，v 有 2k 个 limb 且已规格化；商写进 q[0..k)，余数留在 u[0..2k)
+        void bz_div_3n2n(limb_t* q, limb_t* u, const limb_t* v, size_t k, limb_t* scratch) {
+            const limb_t* v1 = v + k;
+            if (compare_limbs(u + 2 * k, v1, k) < 0) {
+                bz_div_2n1n(q, u + k, v1, k, scratch);
+            } else {
+                // 此时 a1 = v1：商取 BASE^k - 1，r1 = a12 - v1 * BASE^k + v1 = a2 + v1
+                std::fill(q, q + k, BASE - 1);
+                std::fill(u + 2 * k, u + 3 * k, 0);
+                add_limbs(u + k, u + k, 2 * k, v1, k);
+            }
+
+            // u = r1 * BASE^k + a3，减去 q * v2；结果为负时加回除数，最多两次
+            limb_t* product = scratch;
+            mul_limbs(product, q, k, v, k, scratch + 2 * k);
+            if (sub_limbs(u, u, 3 * k, product, 2 * k)) {
+                do {
+                    sub_limbs(q, q, k, &ONE, 1);
+                } while (!add_limbs(u, u, 3 * k, v, 2 * k));
+            }
+        }
+    }
+
+    // Knuth 算法 D：a、b 非负且 b 非零，逐 limb 求商，每步最多修正两次
+    BigInteger divide_knuth(const BigInteger& a, const BigInteger& b, BigInteger& remainder) {
+        BIGINTEGER_STAT(Knuth, b.digits.size());
+        if (compare_abs(a, b) < 0) {
+            remainder = a;
+            return from_longlong(0);
+        }
+
+        const size_t n = b.digits.size();
+        if (n == 1) {
+            BigInteger quotient = a;
+            remainder = from_longlong(divmod_small(quotient, b.digits[0]));
+            return quotient;
+        }
+
+        // 规格化：使除数最高 limb 不小于 BASE / 2
+        // 规格化后的被除数与除数放在线程的临时缓冲区里，只有商和余数需要分配
+        const limb_t d = BASE / (b.digits[n - 1] + 1);
+        const size_t nu = a.digits.size() + 1;
+        ScratchFrame frame;
+        limb_t* u = frame.limbs(nu + n);
+        limb_t* v = u + nu;
+        load_scaled(u, nu, a, d, 0);
+        load_scaled(v, n, b, d, 0);
+
+        BigInteger quotient;
+        quotient.digits.assign(nu - n, 0);
+        knuth_limbs(quotient.digits.data(), u, nu, v, n);
+
+        remainder.digits.assign(u, u + n);
+        remainder.is_negative = false;
+        remove_leading_zeros(remainder);
+        divmod_small(remainder, d);
+        remove_leading_zeros(quotient);
+        return quotient;
+    }
+
+    BigInteger divide_bz(const BigInteger& a, const BigInteger& b, BigInteger& remainder) {
+        BIGINTEGER_STAT(BurnikelZiegler, b.digits.size());
+        if (compare_abs(a, b) < 0) {
+            remainder = a;
+            return from_longlong(0);
+        }
+        const size_t n = b.digits.size();
+        if (n < 2)
+            return divide_knuth(a, b, remainder);
+
+        // 规格化后把除数补到 j * 2^k 个 limb，使递归每层都能对半分
+        const limb_t d = BASE / (b.digits.back() + 1);
+        size_t blocks = 1;
+        while (blocks * thresholds().bz < n) blocks *= 2;
+        const size_t padded = (n + blocks - 1) / blocks * blocks;
+        const size_t shift = padded - n;
+
+        // 规格化的除数与被除数、递归的临时空间一次从 ScratchFrame 取出。被除数按 padded 分块，最高块小于除数；
+        // 从高位起第 i 步把 u[i*padded, (i+2)*padded) 的商写进第 i 块，余数原地留作下一步窗口的高半部分
+        const size_t count = (a.digits.size() + shift + 1) / padded + 1;
+        ScratchFrame frame;
+        limb_t* v = frame.limbs(padded + count * padded + bz_scratch(padded));
+        limb_t* u = v + padded;
+        limb_t* rest = u + count * padded;
+        load_scaled(v, padded, b, d, shift);
+        load_scaled(u, count * padded, a, d, shift);
+
+        BigInteger quotient;
+        quotient.digits.assign((count - 1) * padded, 0);
+        for (size_t i = count - 1; i-- > 0;)
+            bz_div_2n1n(quotient.digits.data() + i * padded, u + i * padded, v, padded, rest);
+
+        remainder.digits.assign(u + shift, u + padded);
+        remainder.is_negative = false;
+        remove_leading_zeros(remainder);
+        divmod_small(remainder, d);
+        remove_leading_zeros(quotient);
+        return quotient;
+    }
+
+    namespace {
+
+        // 返回 floor(BASE^(2n) / b) 的近似值，误差只有几个单位；n 为 b 的 limb 数
+        BigInteger approximate_reciprocal(const BigInteger& b) {
+            const size_t n = b.digits.size();
+            if (n <= RECIPROCAL_BASECASE) {
+                BigInteger r;
+                return divide_knuth(power_of_base(2 * n), b, r);
+            }
+
+            // 高 h 个 limb 的倒数按 BASE^(n-h) 放大后作为初值，多取两个 limb 使一次迭代后误差仍只有几个单位
+            const size_t h = n / 2 + 2;
+            BigInteger x = shift_left(approximate_reciprocal(get_upper(b, n - h)), n - h);
+
+            // x += x * (BASE^(2n) - b * x) / BASE^(2n)
+            BigInteger e = power_of_base(2 * n) - b * x;
+            BigInteger correction = x * e;
+            bool negative = correction.is_negative;
+            correction = get_upper(correction, 2 * n);
+            remove_leading_zeros(correction);
+            correction.is_negative = negative && !is_zero(correction);
+            return x + correction;
+        }
+    }
+
+    // 返回 floor(BASE^(2n) / b)，n 为 b 的 limb 数；Newton 迭代每次精度翻倍，只在最外层修正到精确值
+    BigInteger reciprocal(const BigInteger& b) {
+        BIGINTEGER_STAT(Reciprocal, b.digits.size());
+        BigInteger x = approximate_reciprocal(b);
+        BigInteger r = power_of_base(2 * b.digits.size()) - b * x;
+        while (r.is_negative) {
+            sub_small(x, 1);
+            r = r + b;
+        }
+        while (compare_abs(r, b) >= 0) {
+            add_small(x, 1);
+            r = r - b;
+        }
+        return x;
+    }
+
+    BigInteger divide_newton(const BigInteger& a, const BigInteger& b, BigInteger& remainder) {
+        BIGINTEGER_STAT(Newton, b.digits.size());
+        if (compare_abs(a, b) < 0) {
+            remainder = a;
+            return from_longlong(0);
+        }
+
+        const size_t n = b.digits.size();
+        const BigInteger x = reciprocal(b);
+        const size_t nx = x.digits.size();
+
+        // 与 divide_bz 一样逐块在被除数上原地进行；被除数、估商用的乘积和 q * b 一次从 ScratchFrame 取出
+        const size_t count = a.digits.size() / n + 1;
+        ScratchFrame frame;
+        limb_t* u = frame.limbs(count * n + (n + 1 + nx) + 2 * n + std::max(mul_scratch(n + 1, nx), mul_scratch(n, n)));
+        limb_t* estimate = u + count * n;
+        limb_t* product = estimate + (n + 1 + nx);
+        limb_t* rest = product + 2 * n;
+        load_scaled(u, count * n, a, 1, 0);
+
+        BigInteger quotient;
+        quotient.digits.assign((count - 1) * n, 0);
+        for (size_t i = count - 1; i-- > 0;) {
+            limb_t* z = u + i * n;
+            limb_t* q = quotient.digits.data() + i * n;
+            // z < b * BASE^n：用 z 的高 n+1 个 limb 乘倒数估商，两次向下取整使估计值不超过真商，至多小 3
+            mul_limbs(estimate, z + n - 1, n + 1, x.digits.data(), nx, rest);
+            std::copy(estimate + n + 1, estimate + 2 * n + 1, q);
+            mul_limbs(product, q, n, b.digits.data(), n, rest);
+            sub_limbs(z, z, 2 * n, product, 2 * n);
+            while (at_least(z, 2 * n, b.digits.data(), n)) {
+                sub_limbs(z, z, 2 * n, b.digits.data(), n);
+                add_limbs(q, q, n, &ONE, 1);
+            }
+        }
+
+        remainder.digits.assign(u, u + n);
+        remainder.is_negative = false;
+        remove_leading_zeros(remainder);
+        remove_leading_zeros(quotient);
+        return quotient;
+    }
+
+    // 按商和除数中较短的一方选择算法；a、b 非负且 a >= b
+    BigInteger divide_abs(const BigInteger& a, const BigInteger& b, BigInteger& remainder) {
+        const Thresholds& t = thresholds();
+        const size_t n = b.digits.size();
+        const size_t q_len = a.digits.size() - n + 1;
+        const size_t size = std::min(n, q_len);
+
+        if (size < t.bz)
+            return divide_knuth(a, b, remainder);
+
+        // 商远短于除数时，先用两者的高位估商（误差至多 ±2），再用一次不平衡乘法求余数
+        if (q_len + 1 < n) {
+            const size_t s = n - q_len - 1;
+            BigInteger unused;
+            BigInteger q = divide_abs(get_upper(a, s), get_upper(b, s), unused);
+            remainder = a - q * b;
+            while (remainder.is_negative) {
+                sub_small(q, 1);
+                remainder = remainder + b;
+            }
+            while (compare_abs(remainder, b) >= 0) {
+                add_small(q, 1);
+                remainder = remainder - b;
+            }
+            return q;
+        }
+
+        if (size < t.newton)
+            return divide_bz(a, b, remainder);
+        return divide_newton(a, b, remainder);
+    }
+
+    void divide_decimal_stream(const BigInteger& a, const BigInteger& b, size_t precision,
+                               const std::function<void(std::string_view)>& sink) {
+        BIGINTEGER_STAT(DivideDecimal, b.digits.size());
+        if (is_zero(b)) {
+            throw std::invalid_argument("Division by zero");
+        }
+
+        const BigInteger divisor = absolute(b);
+        BigInteger r;
+        const BigInteger q = divide(absolute(a), divisor, r);
+        if (a.is_negative != b.is_negative && !(is_zero(q) && is_zero(r))) sink("-");
+        sink(to_string(q));
+        if (is_zero(r) || precision == 0) return;
+        sink(".");
+
+        // 每块 k 个 limb：block = floor(r * BASE^k / b)，r = r * BASE^k - block * b。
+        // 总共不超过除数长度时一次除法即可；否则先求一次 inverse = floor(BASE^(n+k) / b)，
+        // 之后每块只需两次乘法，估商 floor(r * inverse / BASE^n) 最多差几个单位
+        const size_t n = divisor.digits.size();
+        const size_t needed = (precision + BASE_DIGITS - 1) / BASE_DIGITS;
+        const bool direct = needed <= n;
+        const size_t k = direct ? needed : std::max(n, std::min(needed, DECIMAL_BLOCK_LIMBS));
+        const BigInteger inverse = direct ? BigInteger() : reciprocal(shift_left(divisor, k - n));
+
+        std::string digits;
+        for (size_t done = 0; done < precision;) {
+            BigInteger block;
+            if (direct) {
+                BigInteger rem;
+                block = divide(shift_left(r, k), divisor, rem);
+                r = std::move(rem);
+            } else {
+                block = get_upper(r * inverse, n);
+                remove_leading_zeros(block);
+                r = shift_left(r, k) - block * divisor;
+                while (r.is_negative) {
+                    sub_small(block, 1);
+                    r += divisor;
+                }
+                while (compare_abs(r, divisor) >= 0) {
+                    add_small(block, 1);
+                    r -= divisor;
+                }
+            }
+
+            write_padded(digits, block, k);
+            const size_t take = std::min(digits.size(), precision - done);
+            // 展开在本块内终止时去掉末尾的零，与逐位计算时余数为零即停止的结果一致
+            if (is_zero(r)) {
+                const size_t end = digits.find_last_not_of('0') + 1;
+                if (end <= take) {
+                    sink(std::string_view(digits.data(), end));
+                    return;
+                }
+            }
+            sink(std::string_view(digits.data(), take));
+            done += take;
+        }
+    }
+}
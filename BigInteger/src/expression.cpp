@@ -0,0 +1,270 @@
+#include <BigInteger/biginteger.h>
+
+#include <deque>
+
+namespace Biginteger{
+
+    namespace {
+
+        using Op = CompiledExpression::Op;
+        using Source = CompiledExpression::Source;
+        using Operand = CompiledExpression::Operand;
+
+        // 编译期的值：常量直接保存数值以便折叠，其余记下它所在的操作数
+        struct Value {
+            bool constant = false;
+            BigInteger number;
+            Operand operand{};
+        };
+
+        // 递归下降解析，直接扫描字符串；depth 是结果要写入的寄存器，右操作数使用 depth + 1
+        class Compiler {
+        public:
+            Compiler(const std::string& text, CompiledExpression& out) : text(text), out(out) {}
+
+            void run() {
+                Value v = expr(0);
+                skip_spaces();
+                if (pos != text.size())
+                    throw std::invalid_argument("Unexpected token at position " + std::to_string(pos) + " in expression");
+                out.result = operand(v);
+            }
+
+        private:
+            const std::string& text;
+            CompiledExpression& out;
+            size_t pos = 0;
+
+            void skip_spaces() {
+                while (pos < text.size() && isspace((unsigned char)text[pos])) ++pos;
+            }
+
+            bool accept(char c) {
+                skip_spaces();
+                if (pos < text.size() && text[pos] == c) {
+                    ++pos;
+                    return true;
+                }
+                return false;
+            }
+
+            Operand operand(const Value& v) {
+                if (!v.constant) return v.operand;
+                out.constants.push_back(v.number);
+                return {Source::Constant, (uint32_t)(out.constants.size() - 1)};
+            }
+
+            Value in_register(size_t depth) {
+                out.registers = std::max(out.registers, depth + 1);
+                Value v;
+                v.operand = {Source::Register, (uint32_t)depth};
+                return v;
+            }
+
+            Value constant(BigInteger number) {
+                Value v;
+                v.constant = true;
+                v.number = std::move(number);
+                return v;
+            }
+
+            Value binary(Op op, size_t depth, const Value& a, const Value& b) {
+                // 除数为零的常量除法留到求值时再报错
+                if (a.constant && b.constant && !(op == Op::Div && is_zero(b.number))) {
+                    switch (op) {
+                        case Op::Add: return constant(a.number + b.number);
+                        case Op::Sub: return constant(a.number - b.number);
+                        case Op::Mul: return constant(a.number * b.number);
+                        default: return constant(a.number / b.number);
+                    }
+                }
+                out.code.push_back({op, (uint32_t)depth, operand(a), operand(b)});
+                return in_register(depth);
+            }
+
+            Value expr(size_t depth) {
+                Value left = term(depth);
+                for (;;) {
+                    if (accept('+')) left = binary(Op::Add, depth, left, term(depth + 1));
+                    else if (accept('-')) left = binary(Op::Sub, depth, left, term(depth + 1));
+                    else return left;
+                }
+            }
+
+            // "/" 与 "//" 都是向零截断的整数除法；"//" 的两个斜杠之间不能有空白
+            Value term(size_t depth) {
+                Value left = primary(depth);
+                for (;;) {
+                    if (accept('*')) {
+                        left = binary(Op::Mul, depth, left, primary(depth + 1));
+                    } else if (accept('/')) {
+                        if (pos < text.size() && text[pos] == '/') ++pos;
+                        left = binary(Op::Div, depth, left, primary(depth + 1));
+                    } else {
+                        return left;
+                    }
+                }
+            }
+
+            Value primary(size_t depth) {
+                skip_spaces();
+                if (pos == text.size()) throw std::invalid_argument("Unexpected end of expression");
+
+                if (accept('(')) {
+                    Value v = expr(depth);
+                    if (!accept(')')) throw std::invalid_argument("Expected ')'");
+                    return v;
+                }
+                if (accept('-')) { // 一元负号
+                    Value v = primary(depth);
+                    if (v.constant) return constant(negate(std::move(v.number)));
+                    out.code.push_back({Op::Neg, (uint32_t)depth, operand(v), {}});
+                    return in_register(depth);
+                }
+
+                const size_t start = pos;
+                if (isdigit((unsigned char)text[pos])) {
+                    while (pos < text.size() && isdigit((unsigned char)text[pos])) ++pos;
+                    return constant(from_string(text.substr(start, pos - start)));
+                }
+                if (isalpha((unsigned char)text[pos]) || text[pos] == '_') {
+                    while (pos < text.size() && (isalnum((unsigned char)text[pos]) || text[pos] == '_')) ++pos;
+                    const std::string name = text.substr(start, pos - start);
+                    if (accept('(')) return call(name, depth);
+                    return variable(name);
+                }
+                throw std::invalid_argument("Unexpected token: " + text.substr(pos, 1));
+            }
+
+            Value variable(const std::string& name) {
+                auto it = std::find(out.variables.begin(), out.variables.end(), name);
+                if (it == out.variables.end()) it = out.variables.insert(it, name);
+                Value v;
+                v.operand = {Source::Variable, (uint32_t)(it - out.variables.begin())};
+                return v;
+            }
+
+            // 函数调用（如 sum(1, 2)），第 i 个参数写入寄存器 depth + i
+            Value call(const std::string& name, size_t depth) {
+                Op op;
+                if (name == "sum") op = Op::Sum;
+                else if (name == "max") op = Op::Max;
+                else throw std::invalid_argument("Unknown function: " + name);
+
+                std::vector<Value> args;
+                if (!accept(')')) {
+                    do {
+                        args.push_back(expr(depth + args.size()));
+                    } while (accept(','));
+                    if (!accept(')')) throw std::invalid_argument("Expected ')'");
+                }
+                if (op == Op::Max && args.empty())
+                    throw std::invalid_argument("max() requires at least one argument");
+
+                if (std::all_of(args.begin(), args.end(), [](const Value& v) { return v.constant; })) {
+                    std::vector<BigInteger> numbers;
+                    for (auto& v : args) numbers.push_back(std::move(v.number));
+                    return constant(op == Op::Sum ? sum(numbers) : max(numbers));
+                }
+
+                const uint32_t first = (uint32_t)out.arguments.size();
+                for (const auto& v : args) out.arguments.push_back(operand(v));
+                out.code.push_back({op, (uint32_t)depth, {Source::Register, first}, {Source::Register, (uint32_t)args.size()}});
+                return in_register(depth);
+            }
+        };
+
+        void copy_into(BigInteger& dst, const BigInteger& src) {
+            if (&dst == &src) return;
+            dst.digits.assign(src.digits.begin(), src.digits.end());
+            dst.is_negative = src.is_negative;
+        }
+
+        // 每次求值占用一个寄存器帧，按嵌套深度索引。mul 等待并行子任务时本线程可能执行另一次求值，
+        // 它用更深的一帧，不会改动本帧的寄存器；deque 追加新帧时已有的帧不会移动
+        thread_local std::deque<std::vector<BigInteger>> register_frames;
+        thread_local size_t frame_depth = 0;
+
+        class RegisterFrame {
+        public:
+            explicit RegisterFrame(size_t count) {
+                if (frame_depth == register_frames.size()) register_frames.emplace_back();
+                registers = &register_frames[frame_depth++];
+                if (registers->size() < count) registers->resize(count);
+            }
+            ~RegisterFrame() { --frame_depth; }
+            RegisterFrame(const RegisterFrame&) = delete;
+            RegisterFrame& operator=(const RegisterFrame&) = delete;
+            BigInteger& operator[](size_t i) { return (*registers)[i]; }
+
+        private:
+            std::vector<BigInteger>* registers;
+        };
+    }
+
+    CompiledExpression compile(const std::string& expr) {
+        CompiledExpression compiled;
+        Compiler(expr, compiled).run();
+        return compiled;
+    }
+
+    size_t variable_index(const CompiledExpression& compiled, const std::string& name) {
+        auto it = std::find(compiled.variables.begin(), compiled.variables.end(), name);
+        if (it == compiled.variables.end())
+            throw std::invalid_argument("Unknown variable: " + name);
+        return it - compiled.variables.begin();
+    }
+
+    // 规模分布按指令条数统计
+    BigInteger evaluate(const CompiledExpression& compiled, const std::vector<BigInteger>& bindings) {
+        BIGINTEGER_STAT(Evaluate, compiled.code.size());
+        if (bindings.size() < compiled.variables.size())
+            throw std::invalid_argument("Missing value for variable: " + compiled.variables[bindings.size()]);
+
+        // 寄存器帧在线程内跨调用复用，已有的容量足够时加减法不再分配
+        RegisterFrame registers(compiled.registers);
+
+        auto value = [&](const Operand& o) -> const BigInteger& {
+            switch (o.source) {
+                case Source::Register: return registers[o.index];
+                case Source::Constant: return compiled.constants[o.index];
+                default: return bindings[o.index];
+            }
+        };
+
+        for (const auto& ins : compiled.code) {
+            BigInteger& dst = registers[ins.dst];
+            switch (ins.op) {
+                case Op::Neg:
+                    copy_into(dst, value(ins.a));
+                    if (!is_zero(dst)) dst.is_negative = !dst.is_negative;
+                    break;
+                case Op::Add: add(dst, value(ins.a), value(ins.b)); break;
+                case Op::Sub: sub(dst, value(ins.a), value(ins.b)); break;
+                case Op::Mul: mul(dst, value(ins.a), value(ins.b)); break;
+                case Op::Div: dst = value(ins.a) / value(ins.b); break;
+                case Op::Sum: {
+                    const Operand* args = &compiled.arguments[ins.a.index];
+                    if (ins.b.index == 0) {
+                        dst.digits.assign(1, 0);
+                        dst.is_negative = false;
+                        break;
+                    }
+                    // 第一个参数就在 dst 中（或是常量/变量），其余的都在更高的寄存器里
+                    copy_into(dst, value(args[0]));
+                    for (uint32_t i = 1; i < ins.b.index; ++i) dst += value(args[i]);
+                    break;
+                }
+                case Op::Max: {
+                    const Operand* args = &compiled.arguments[ins.a.index];
+                    const BigInteger* best = &value(args[0]);
+                    for (uint32_t i = 1; i < ins.b.index; ++i)
+                        if (value(args[i]) > *best) best = &value(args[i]);
+                    copy_into(dst, *best);
+                    break;
+                }
+            }
+        }
+        return value(compiled.result);
+    }
+}
@@ -0,0 +1,239 @@
+#include <BigInteger/biginteger.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 预计算的变换计划：位逆序表与旋转因子表，同一长度的变换反复复用
+        struct FFTPlan {
+            size_t n;
+            std::vector<uint32_t> rev;
+            // roots[len + k] = W_{2len}^k，roots3[len + k] = W_{2len}^{3k}，W_m = e^{2πi/m}
+            std::vector<std::complex<double>> roots, roots3;
+
+            explicit FFTPlan(size_t size) : n(size), rev(size), roots(std::max<size_t>(size, 2)), roots3(std::max<size_t>(size, 2)) {
+                int log_n = 0;
+                while ((size_t(1) << log_n) < n) ++log_n;
+                for (size_t i = 0; i < n; ++i)
+                    rev[i] = (uint32_t)((rev[i >> 1] >> 1) | ((i & 1) << (log_n - 1)));
+
+                // 每个旋转因子直接用 cos/sin 求得，避免连乘累积误差
+                const size_t half = n / 2;
+                for (size_t k = 0; k < half; ++k) {
+                    roots[half + k] = std::polar(1.0, PI * k / half);
+                    roots3[half + k] = std::polar(1.0, PI * 3 * k / half);
+                }
+                for (size_t len = half / 2; len >= 1; len /= 2) {
+                    for (size_t k = 0; k < len; ++k) {
+                        roots[len + k] = roots[2 * (len + k)];
+                        roots3[len + k] = roots3[2 * (len + k)];
+                    }
+                }
+            }
+        };
+
+        std::shared_ptr<const FFTPlan> fft_plan(size_t n) {
+            static std::mutex mutex;
+            static std::map<size_t, std::shared_ptr<const FFTPlan>> plans;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& plan = plans[n];
+            if (!plan) plan = std::make_shared<const FFTPlan>(n);
+            return plan;
+        }
+
+        // std::complex 的乘法要处理 NaN/Inf，这里直接展开
+        inline std::complex<double> cmul(const std::complex<double>& a, const std::complex<double>& b) {
+            return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        template <bool Inv>
+        inline std::complex<double> twiddle(const std::complex<double>& w) {
+            return Inv ? std::conj(w) : w;
+        }
+
+        // 每块至少这么多个蝶形才值得交给线程池
+        const size_t FFT_PARALLEL_GRAIN = 1 << 14;
+
+        // 基 4 的一层中位于 a + i 的一组里第 k 个蝶形
+        template <bool Inv>
+        inline void radix4_butterfly(std::complex<double>* a, const FFTPlan& plan, size_t m, size_t i, size_t k) {
+            const std::complex<double> w1 = twiddle<Inv>(plan.roots[2 * m + k]);
+            const std::complex<double> w2 = twiddle<Inv>(plan.roots[m + k]);
+            const std::complex<double> w3 = twiddle<Inv>(plan.roots3[2 * m + k]);
+            std::complex<double>* p = a + i + k;
+            const std::complex<double> a0 = p[0];
+            const std::complex<double> b1 = cmul(p[m], w2);
+            const std::complex<double> b2 = cmul(p[2 * m], w1);
+            const std::complex<double> b3 = cmul(p[3 * m], w3);
+            const std::complex<double> t0 = a0 + b1, t1 = a0 - b1;
+            const std::complex<double> t2 = b2 + b3, d = b2 - b3;
+            // 乘以 W_4 = ±i
+            const std::complex<double> t3 = Inv ? std::complex<double>(d.imag(), -d.real())
+                                                : std::complex<double>(-d.imag(), d.real());
+            p[0] = t0 + t2;
+            p[2 * m] = t0 - t2;
+            p[m] = t1 + t3;
+            p[3 * m] = t1 - t3;
+        }
+
+        // 位逆序输入的 DIT 变换，每次合并两层蝶形（基 4）；每层内的蝶形互不相关，长变换按层并行
+        template <bool Inv>
+        void fft_radix4(std::complex<double>* a, const FFTPlan& plan) {
+            const size_t n = plan.n;
+            size_t m = 1;
+            if (__builtin_ctzll(n) & 1) {
+                for (size_t i = 0; i < n; i += 2) {
+                    std::complex<double> u = a[i], v = a[i + 1];
+                    a[i] = u + v;
+                    a[i + 1] = u - v;
+                }
+                m = 2;
+            }
+            // 组数多时按组切分，组数少时按组内下标切分
+            for (; m < n; m *= 4) {
+                const size_t groups = n / (4 * m);
+                if (groups >= m) {
+                    parallel_for(0, groups, std::max<size_t>(1, FFT_PARALLEL_GRAIN / m), [&](size_t lo, size_t hi) {
+                        for (size_t g = lo; g < hi; ++g)
+                            for (size_t k = 0; k < m; ++k)
+                                radix4_butterfly<Inv>(a, plan, m, 4 * m * g, k);
+                    });
+                } else {
+                    parallel_for(0, m, std::max<size_t>(1, FFT_PARALLEL_GRAIN / groups), [&](size_t lo, size_t hi) {
+                        for (size_t g = 0; g < groups; ++g)
+                            for (size_t k = lo; k < hi; ++k)
+                                radix4_butterfly<Inv>(a, plan, m, 4 * m * g, k);
+                    });
+                }
+            }
+        }
+
+        // 原地变换长度为 n 的复数序列；inv 为真时是逆变换（未除以 n）
+        void transform(std::complex<double>* a, size_t n, bool inv) {
+            if (n <= 1) {
+                return;
+            }
+
+            std::shared_ptr<const FFTPlan> plan = fft_plan(n);
+            parallel_for(0, n, 4 * FFT_PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    if (i < plan->rev[i]) std::swap(a[i], a[plan->rev[i]]);
+                }
+            });
+            if (inv) fft_radix4<true>(a, *plan);
+            else fft_radix4<false>(a, *plan);
+        }
+    }
+
+    void fft(std::vector<std::complex<double>>& a, bool inv){
+        transform(a.data(), a.size(), inv);
+    }
+
+    // FFT 以 1000 进制运算：每个 limb 拆成 3 段，卷积系数保持在 double 可精确表示的范围内
+    const limb_t FFT_PIECE = 1000;
+    const int FFT_PIECES_PER_LIMB = 3;
+
+    namespace {
+
+        // 把 limb 拆成 1000 进制的段，相邻两段打包成一个复数：z_j = x_{2j} + i x_{2j+1}。
+        // std::complex<double> 与 double[2] 布局相同，按 double 数组逐段写入
+        void pack_pieces(std::complex<double>* z, const limb_t* num, size_t n, size_t half) {
+            std::fill(z, z + half, std::complex<double>());
+            double* pieces = reinterpret_cast<double*>(z);
+            for (size_t i = 0; i < n; i++) {
+                limb_t x = num[i];
+                for (int k = 0; k < FFT_PIECES_PER_LIMB; k++, x /= FFT_PIECE)
+                    pieces[i * FFT_PIECES_PER_LIMB + k] = x % FFT_PIECE;
+            }
+        }
+
+        // 长度 n 实序列的频谱 X_0..X_{n/2} 写进 spectrum，只需一次 n/2 点复数变换（z 被原地变换）
+        void real_spectrum(std::complex<double>* spectrum, std::complex<double>* z, size_t half, const FFTPlan& plan) {
+            transform(z, half, false);
+            for (size_t k = 0; k <= half; k++) {
+                const std::complex<double> zk = z[k % half];
+                const std::complex<double> zc = std::conj(z[(half - k) % half]);
+                const std::complex<double> even = (zk + zc) * 0.5;
+                const std::complex<double> diff = zk - zc;
+                const std::complex<double> odd(diff.imag() * 0.5, -diff.real() * 0.5); // (zk - zc) / 2i
+                const std::complex<double> w = k < half ? plan.roots[half + k] : std::complex<double>(-1.0, 0.0);
+                spectrum[k] = even + cmul(w, odd);
+            }
+        }
+
+        // real_spectrum 的逆：由 X_0..X_{n/2} 还原 n 个实数写进 z，按 z_j = x_{2j} + i x_{2j+1} 排列（未除以 n/2）
+        void real_inverse(std::complex<double>* z, const std::complex<double>* spectrum, size_t half, const FFTPlan& plan) {
+            for (size_t k = 0; k < half; k++) {
+                const std::complex<double> pk = spectrum[k];
+                const std::complex<double> pm = std::conj(spectrum[half - k]); // P_{k + n/2}
+                const std::complex<double> even = (pk + pm) * 0.5;
+                const std::complex<double> odd = cmul((pk - pm) * 0.5, std::conj(plan.roots[half + k]));
+                z[k] = std::complex<double>(even.real() - odd.imag(), even.imag() + odd.real()); // even + i * odd
+            }
+            transform(z, half, true);
+        }
+    }
+
+    void fft_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        BIGINTEGER_STAT(FFT, std::min(na, nb));
+        std::fill(out, out + na + nb, 0);
+        if (na == 0 || nb == 0) return;
+
+        size_t n = 2;
+        while (n < (na + nb) * FFT_PIECES_PER_LIMB) {
+            n *= 2;
+        }
+        const size_t half = n / 2;
+        std::shared_ptr<const FFTPlan> plan = fft_plan(n);
+
+        // 平方只需一次正变换；否则两个操作数的正变换并行。打包的操作数与频谱一次从 ScratchFrame 取出
+        const bool square = na == nb && (a == b || std::equal(a, a + na, b));
+        ScratchFrame frame;
+        std::complex<double>* z = frame.complexes((square ? 1 : 2) * (2 * half + 1));
+        std::complex<double>* c = z + half;
+        if (square) {
+            pack_pieces(z, a, na, half);
+            real_spectrum(c, z, half, *plan);
+            for (size_t k = 0; k <= half; k++) c[k] = cmul(c[k], c[k]);
+        } else {
+            std::complex<double>* zb = c + half + 1;
+            std::complex<double>* d = zb + half;
+            parallel_invoke({
+                [=] { pack_pieces(z, a, na, half); real_spectrum(c, z, half, *plan); },
+                [=] { pack_pieces(zb, b, nb, half); real_spectrum(d, zb, half, *plan); },
+            }, std::min(na, nb));
+            for (size_t k = 0; k <= half; k++) c[k] = cmul(c[k], d[k]);
+        }
+
+        real_inverse(z, c, half, *plan);
+
+        // 先按 1000 进制进位，再每 3 段合成一个 limb；乘积不超过 na + nb 个 limb，更高的段都是零
+        const size_t pieces = (na + nb) * FFT_PIECES_PER_LIMB;
+        uint64_t carry = 0;
+        limb_t scale = 1;
+        for (size_t i = 0; i < pieces; i++) {
+            const double value = (i & 1) ? z[i / 2].imag() : z[i / 2].real();
+            carry += (uint64_t)(value / half + 0.5);
+            out[i / FFT_PIECES_PER_LIMB] += (carry % FFT_PIECE) * scale;
+            carry /= FFT_PIECE;
+            scale = (i % FFT_PIECES_PER_LIMB == FFT_PIECES_PER_LIMB - 1) ? 1 : scale * FFT_PIECE;
+        }
+    }
+
+    BigInteger FFT_multiply(const BigInteger& a, const BigInteger& b){
+        if (is_zero(a) || is_zero(b)) {
+            return from_longlong(0);
+        }
+
+        BigInteger result;
+        result.digits.resize(a.digits.size() + b.digits.size());
+        fft_limbs(result.digits.data(), a.digits.data(), a.digits.size(), b.digits.data(), b.digits.size());
+        remove_leading_zeros(result);
+        result.is_negative = a.is_negative != b.is_negative;
+        return result;
+    }
+}
@@ -0,0 +1,203 @@
+#include <BigInteger/biginteger.h>
+
+#include <numeric>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 约简过程中的每个变换同时作用在所有 (x, y) 上：第 0 对是正在约简的 (a, b)，
+        // 其余是跟着更新的余因子。各变换的行列式都是 ±1，gcd 不变
+        using Pairs = std::vector<std::pair<BigInteger, BigInteger>>;
+
+        // (x, y) ← (A x + B y, C x + D y)
+        void apply_small(Pairs& pairs, int64_t A, int64_t B, int64_t C, int64_t D) {
+            for (auto& [x, y] : pairs) {
+                BigInteger nx = x * A;
+                nx += y * B;
+                y = x * C + y * D;
+                x = std::move(nx);
+            }
+        }
+
+        // (x, y) ← (m00 x + m01 y, m10 x + m11 y)
+        void apply_matrix(Pairs& pairs, const Pairs& m) {
+            const BigInteger &m00 = m[1].first, &m10 = m[1].second, &m01 = m[2].first, &m11 = m[2].second;
+            for (auto& [x, y] : pairs) {
+                BigInteger nx = m00 * x + m01 * y;
+                y = m10 * x + m11 * y;
+                x = std::move(nx);
+            }
+        }
+
+        // 一次完整的带余除法：(a, b) ← (b, a mod b)，余因子 (x, y) ← (y, x - q y)
+        void division_step(Pairs& pairs) {
+            BigInteger r;
+            BigInteger q = divide_abs(pairs[0].first, pairs[0].second, r);
+            remove_leading_zeros(q);
+            remove_leading_zeros(r);
+            pairs[0].first = std::move(pairs[0].second);
+            pairs[0].second = std::move(r);
+            for (size_t i = 1; i < pairs.size(); ++i) {
+                auto& [x, y] = pairs[i];
+                x -= q * y;
+                std::swap(x, y);
+            }
+        }
+
+        // 恢复 a >= b >= 0：由近似值得到的变换可能让结果略微变号或次序颠倒
+        void normalize(Pairs& pairs) {
+            if (pairs[0].first.is_negative)
+                for (auto& p : pairs) p.first = negate(std::move(p.first));
+            if (pairs[0].second.is_negative)
+                for (auto& p : pairs) p.second = negate(std::move(p.second));
+            if (compare_abs(pairs[0].first, pairs[0].second) < 0)
+                for (auto& p : pairs) std::swap(p.first, p.second);
+        }
+
+        // Lehmer：a、b 对齐后的最高两个 limb（不超过 10^18）上做欧几里得，两个商的上下界相同时才采用。
+        // 得到的系数矩阵 [[A, B], [C, D]] 在一次线性组合里推进多步；返回 false 表示近似不够，应做完整除法
+        bool lehmer_matrix(const BigInteger& a, const BigInteger& b, int64_t& A, int64_t& B, int64_t& C, int64_t& D) {
+            const size_t n = a.digits.size();
+            if (n < 2 || b.digits.size() + 1 < n) return false;
+            int64_t ah = (int64_t)a.digits[n - 1] * BASE + a.digits[n - 2];
+            int64_t bh = (b.digits.size() == n ? (int64_t)b.digits[n - 1] * BASE : 0) + b.digits[n - 2];
+
+            A = 1, B = 0, C = 0, D = 1;
+            while (bh + C > 0 && bh + D > 0) {
+                const int64_t q = (ah + A) / (bh + C);
+                if (q != (ah + B) / (bh + D)) break;
+                int64_t t = A - q * C;
+                A = C, C = t;
+                t = B - q * D;
+                B = D, D = t;
+                t = ah - q * bh;
+                ah = bh, bh = t;
+            }
+            return B != 0;
+        }
+
+        // 约简到 b 不超过 stop 个 limb（或为零）
+        void lehmer_reduce(Pairs& pairs, size_t stop) {
+            while (!is_zero(pairs[0].second) && pairs[0].second.digits.size() > stop) {
+                int64_t A, B, C, D;
+                if (lehmer_matrix(pairs[0].first, pairs[0].second, A, B, C, D)) {
+                    apply_small(pairs, A, B, C, D);
+                    normalize(pairs);
+                } else {
+                    division_step(pairs);
+                }
+            }
+        }
+
+        // 半 GCD：返回矩阵 M（pairs[1]、pairs[2] 为两列），M (a, b) 约为 a 的一半长。
+        // 矩阵由高位部分递归求得：先用高 n/2 个 limb 降到约 3n/4，再取一段高位降到 n/2，
+        // 两次递归加上几次全长乘法，总代价为 O(M(n) log n)。高位给出的矩阵对全长未必恰好是欧几里得序列，
+        // 但行列式为 ±1，normalize 之后仍是正确的约简，只是少推进一点
+        Pairs half_gcd(const BigInteger& a, const BigInteger& b) {
+            BIGINTEGER_STAT(HalfGcd, a.digits.size());
+            const size_t n = a.digits.size();
+            const size_t target = n / 2 + 1;
+            Pairs pairs = {{a, b}, {from_longlong(1), from_longlong(0)}, {from_longlong(0), from_longlong(1)}};
+            // 高位部分太短时 Lehmer 推进不了几步，递归至少停在 8 个 limb
+            if (n < std::max<size_t>(thresholds().hgcd, 8)) {
+                lehmer_reduce(pairs, target);
+                return pairs;
+            }
+
+            const size_t m = n / 2;
+            if (pairs[0].second.digits.size() > target) {
+                apply_matrix(pairs, half_gcd(upper(a, m), upper(b, m)));
+                normalize(pairs);
+            }
+            const size_t n2 = pairs[0].first.digits.size();
+            if (!is_zero(pairs[0].second) && pairs[0].second.digits.size() > target && n2 > target) {
+                const size_t m2 = 2 * target > n2 ? 2 * target - n2 : 0;
+                apply_matrix(pairs, half_gcd(upper(pairs[0].first, m2), upper(pairs[0].second, m2)));
+                normalize(pairs);
+            }
+            return pairs;
+        }
+
+        // 约简到 b = 0，pairs[0].first 即为 gcd；has_cofactors 为假时最后两个 limb 以内直接用机器字
+        void gcd_reduce(Pairs& pairs, bool has_cofactors) {
+            normalize(pairs);
+            while (!is_zero(pairs[0].second)) {
+                BigInteger& a = pairs[0].first;
+                BigInteger& b = pairs[0].second;
+                const size_t n = a.digits.size();
+
+                if (!has_cofactors && n <= 2) {
+                    auto word = [](const BigInteger& x) {
+                        return (uint64_t)x.digits[0] + (x.digits.size() > 1 ? (uint64_t)x.digits[1] * BASE : 0);
+                    };
+                    a = from_longlong((long long)std::gcd(word(a), word(b)));
+                    b = from_longlong(0);
+                    return;
+                }
+
+                int64_t A, B, C, D;
+                if (n > b.digits.size() + 1) {
+                    division_step(pairs);
+                } else if (n >= thresholds().hgcd) {
+                    apply_matrix(pairs, half_gcd(a, b));
+                    normalize(pairs);
+                    // 没有推进时退回一步除法
+                    if (!is_zero(pairs[0].second) && pairs[0].first.digits.size() >= n) division_step(pairs);
+                } else if (lehmer_matrix(a, b, A, B, C, D)) {
+                    apply_small(pairs, A, B, C, D);
+                    normalize(pairs);
+                } else {
+                    division_step(pairs);
+                }
+            }
+        }
+    }
+
+    BigInteger gcd(const BigInteger& a, const BigInteger& b) {
+        BIGINTEGER_STAT(Gcd, std::min(a.digits.size(), b.digits.size()));
+        Pairs pairs = {{absolute(a), absolute(b)}};
+        gcd_reduce(pairs, false);
+        return std::move(pairs[0].first);
+    }
+
+    BigInteger xgcd(const BigInteger& a, const BigInteger& b, BigInteger& s, BigInteger& t) {
+        BIGINTEGER_STAT(Gcd, std::min(a.digits.size(), b.digits.size()));
+        const BigInteger x = absolute(a), y = absolute(b);
+        if (is_zero(y)) {
+            s = from_longlong(is_zero(x) ? 0 : a.is_negative ? -1 : 1);
+            t = from_longlong(0);
+            return x;
+        }
+
+        // 第二对记录 a、b 各自是 x 的多少倍（模 y）
+        Pairs pairs = {{x, y}, {from_longlong(1), from_longlong(0)}};
+        gcd_reduce(pairs, true);
+        BigInteger g = std::move(pairs[0].first);
+
+        // 把 s 规范到 [0, y / g)，再由 s x + t y = g 求出 t
+        const BigInteger period = y / g;
+        s = pairs[1].first % period;
+        if (s.is_negative) s += period;
+        t = (g - s * x) / y;
+
+        if (a.is_negative) s = negate(std::move(s));
+        if (b.is_negative) t = negate(std::move(t));
+        return g;
+    }
+
+    BigInteger modinv(const BigInteger& a, const BigInteger& modulus) {
+        if (modulus.is_negative || is_zero(modulus)) {
+            throw std::invalid_argument("Modulus must be positive");
+        }
+        BigInteger r = a % modulus;
+        if (r.is_negative) r += modulus;
+
+        BigInteger s, t;
+        BigInteger g = xgcd(r, modulus, s, t);
+        if (!(g == 1)) {
+            throw std::invalid_argument("Not invertible");
+        }
+        return s % modulus; // 模数为 1 时 s 为 0
+    }
+}
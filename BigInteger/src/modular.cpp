@@ -0,0 +1,230 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        bool is_one(const BigInteger& num) {
+            return num.digits.size() == 1 && num.digits[0] == 1;
+        }
+
+        // x^{-1} mod BASE，要求 x 与 BASE 互素
+        limb_t inverse_word(limb_t x) {
+            int64_t r0 = BASE, r1 = x, t0 = 0, t1 = 1;
+            while (r1 != 0) {
+                const int64_t q = r0 / r1;
+                const int64_t r = r0 - q * r1, t = t0 - q * t1;
+                r0 = r1, r1 = r;
+                t0 = t1, t1 = t;
+            }
+            return (limb_t)(t0 < 0 ? t0 + BASE : t0);
+        }
+
+        // m^{-1} mod BASE^n：Hensel 提升，x(2 - m x) 每步把正确的 limb 数加倍
+        BigInteger inverse_mod_base_power(const BigInteger& m, size_t n) {
+            BigInteger x = from_longlong(inverse_word(m.digits[0]));
+            for (size_t k = 1; k < n;) {
+                k = std::min(2 * k, n);
+                BigInteger e = lower(lower(m, k) * x, k);
+                // 加上 BASE^k 使 2 - e 保持非负
+                x = lower(x * (shift_left(from_longlong(1), k) + 2 - e), k);
+            }
+            return x;
+        }
+
+        // Barrett 约简：0 <= x < BASE^(2n)，结果在 [0, m)
+        void barrett(const ModContext& ctx, BigInteger& x) {
+            if (x.digits.size() < ctx.n || compare_abs(x, ctx.modulus) < 0) return;
+            BigInteger q = upper(upper(x, ctx.n - 1) * ctx.mu, ctx.n + 1);
+            x -= q * ctx.modulus;
+            while (compare_abs(x, ctx.modulus) >= 0) x -= ctx.modulus; // 商最多少估 2
+        }
+
+        // Montgomery 约简：0 <= t < m * BASE^n，t 变为 t * BASE^{-n} mod m
+        // 模数短时逐 limb 消去最低位，长时用两次乘法 u = t * m^{-1} mod BASE^n、(t - u m) / BASE^n
+        void redc(const ModContext& ctx, BigInteger& t) {
+            const size_t n = ctx.n;
+            if (!ctx.inverse.digits.empty()) {
+                BigInteger u = lower(lower(t, n) * ctx.inverse, n);
+                t -= u * ctx.modulus;
+                // 低 n 位已被消成零，差在 (-m, m) 内
+                const bool negative = t.is_negative;
+                t = upper(t, n);
+                if (negative && !is_zero(t)) t = ctx.modulus - t;
+                return;
+            }
+
+            const size_t nt = t.digits.size();
+            t.digits.resize(std::max(nt, n + 1));
+            redc_limbs(t.digits.data(), t.digits.data(), nt, ctx.modulus.digits.data(), n, ctx.inverse_word);
+            t.digits.resize(n + 1);
+            remove_leading_zeros(t);
+            if (compare_abs(t, ctx.modulus) >= 0) t -= ctx.modulus;
+        }
+
+        // 指数的二进制位，低位在前；每次取下 2^32 的余数
+        std::vector<uint32_t> binary_words(BigInteger e) {
+            std::vector<uint32_t> words;
+            while (!is_zero(e)) words.push_back((uint32_t)divmod_small(e, (int64_t)1 << 32));
+            return words;
+        }
+
+        // 滑动窗口的宽度，随指数位数增大
+        size_t window_bits(size_t bits) {
+            if (bits > 671) return 6;
+            if (bits > 239) return 5;
+            if (bits > 79) return 4;
+            if (bits > 23) return 3;
+            return bits > 7 ? 2 : 1;
+        }
+
+        // 模数只有一个 limb 时全部在 uint64_t 内完成，乘积小于 BASE^2 不会溢出；窗口与多 limb 的情形相同
+        BigInteger powmod_word(uint64_t x, const BigInteger& exp, uint64_t m) {
+            if (is_zero(exp)) return from_longlong((long long)(1 % m));
+            const std::vector<uint32_t> words = binary_words(exp);
+            auto bit = [&](size_t i) { return (words[i / 32] >> (i % 32)) & 1; };
+            size_t bits = 32 * words.size();
+            while (!bit(bits - 1)) --bits;
+
+            const size_t k = window_bits(bits);
+            uint64_t odd[size_t(1) << 5];
+            odd[0] = x % m;
+            const uint64_t x2 = odd[0] * odd[0] % m;
+            for (size_t i = 1; i < (size_t(1) << (k - 1)); ++i) odd[i] = odd[i - 1] * x2 % m;
+
+            uint64_t result = 1 % m;
+            for (size_t i = bits; i-- > 0;) {
+                if (!bit(i)) {
+                    result = result * result % m;
+                    continue;
+                }
+                size_t low = i + 1 >= k ? i + 1 - k : 0;
+                while (!bit(low)) ++low;
+                size_t value = 0;
+                for (size_t j = i + 1; j-- > low;) {
+                    value = value * 2 + bit(j);
+                    result = result * result % m;
+                }
+                result = result * odd[value / 2] % m;
+                i = low;
+            }
+            return from_longlong((long long)result);
+        }
+    }
+
+    ModContext mod_context(const BigInteger& modulus) {
+        if (modulus.is_negative || is_zero(modulus)) {
+            throw std::invalid_argument("Modulus must be positive");
+        }
+
+        ModContext ctx;
+        ctx.modulus = modulus;
+        ctx.n = modulus.digits.size();
+        ctx.mu = reciprocal(modulus);
+
+        const limb_t low = modulus.digits[0];
+        ctx.montgomery = low % 2 != 0 && low % 5 != 0 && !is_one(modulus);
+        if (ctx.montgomery) {
+            ctx.inverse_word = BASE - inverse_word(low);
+            // 按乘积约简要两次全长乘法，到 FFT 的范围才比逐 limb 约简划算
+            if (ctx.n >= thresholds().fft) ctx.inverse = inverse_mod_base_power(modulus, ctx.n);
+
+            // BASE^n mod m 有 n + 1 个 limb，在 Barrett 的范围内；平方后再约简一次得到 BASE^(2n) mod m
+            BigInteger r = shift_left(from_longlong(1), ctx.n);
+            barrett(ctx, r);
+            ctx.r2 = r * r;
+            barrett(ctx, ctx.r2);
+        }
+        return ctx;
+    }
+
+    BigInteger mod_reduce(const ModContext& ctx, const BigInteger& x) {
+        BigInteger r;
+        if (x.digits.size() <= 2 * ctx.n) {
+            r = absolute(x);
+            barrett(ctx, r);
+        } else {
+            divide_abs(absolute(x), ctx.modulus, r);
+            remove_leading_zeros(r);
+        }
+        if (x.is_negative && !is_zero(r)) r = ctx.modulus - r;
+        return r;
+    }
+
+    BigInteger mod_mul(const ModContext& ctx, const BigInteger& a, const BigInteger& b) {
+        BigInteger product = mod_reduce(ctx, a) * mod_reduce(ctx, b);
+        barrett(ctx, product);
+        return product;
+    }
+
+    BigInteger powmod(const ModContext& ctx, const BigInteger& base, const BigInteger& exp) {
+        BIGINTEGER_STAT(PowMod, ctx.n);
+        if (exp.is_negative) return powmod(ctx, modinv(base, ctx.modulus), negate(exp)); // base 不可逆时抛出异常
+        BigInteger x = mod_reduce(ctx, base);
+        if (ctx.n == 1) return powmod_word(x.digits[0], exp, ctx.modulus.digits[0]);
+        if (is_zero(exp)) return from_longlong(1);
+
+        // 乘积都在 [0, m^2) 内；Montgomery 形式下元素是 x * BASE^n mod m
+        auto reduce = [&](BigInteger& v) {
+            if (ctx.montgomery) redc(ctx, v);
+            else barrett(ctx, v);
+        };
+        auto multiply = [&](BigInteger& acc, const BigInteger& y) {
+            acc *= y;
+            reduce(acc);
+        };
+        auto square = [&](BigInteger& acc) {
+            acc = acc * acc;
+            reduce(acc);
+        };
+        if (ctx.montgomery) multiply(x, ctx.r2);
+
+        const std::vector<uint32_t> words = binary_words(exp);
+        auto bit = [&](size_t i) { return (words[i / 32] >> (i % 32)) & 1; };
+        size_t bits = 32 * words.size();
+        while (!bit(bits - 1)) --bits;
+
+        // 预先算出奇数次幂 x, x^3, ..., x^(2^k - 1)
+        const size_t k = window_bits(bits);
+        std::vector<BigInteger> odd(size_t(1) << (k - 1));
+        odd[0] = x;
+        if (odd.size() > 1) {
+            BigInteger x2 = x;
+            square(x2);
+            for (size_t i = 1; i < odd.size(); ++i) {
+                odd[i] = odd[i - 1];
+                multiply(odd[i], x2);
+            }
+        }
+
+        // 从高位向低位，每个窗口以 1 结尾，窗口之间的 0 逐位平方
+        BigInteger result;
+        bool started = false;
+        for (size_t i = bits; i-- > 0;) {
+            if (!bit(i)) {
+                square(result);
+                continue;
+            }
+            size_t low = i + 1 >= k ? i + 1 - k : 0;
+            while (!bit(low)) ++low;
+            size_t value = 0;
+            for (size_t j = i + 1; j-- > low;) value = value * 2 + bit(j);
+
+            if (started) {
+                for (size_t j = low; j <= i; ++j) square(result);
+                multiply(result, odd[value / 2]);
+            } else {
+                result = odd[value / 2];
+                started = true;
+            }
+            i = low;
+        }
+
+        if (ctx.montgomery) redc(ctx, result);
+        return result;
+    }
+
+    BigInteger powmod(const BigInteger& base, const BigInteger& exp, const BigInteger& modulus) {
+        return powmod(mod_context(modulus), base, exp);
+    }
+}
@@ -0,0 +1,266 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 32 位 Montgomery 运算，R = 2^32，要求模数 p < 2^31
+        struct Montgomery32 {
+            uint32_t p;
+            uint32_t p_inv_neg; // -p^{-1} mod 2^32
+            uint32_t r2;        // R^2 mod p
+
+            explicit Montgomery32(uint32_t mod) : p(mod) {
+                uint32_t inv = mod; // 对奇数 p，p * p ≡ 1 (mod 8)，每次 Newton 迭代精度翻倍
+                for (int i = 0; i < 4; ++i)
+                    inv *= 2 - mod * inv;
+                p_inv_neg = 0u - inv;
+                uint64_t r = (~0ULL % mod + 1) % mod; // 2^64 mod p
+                r2 = (uint32_t)r;
+            }
+
+            uint32_t reduce(uint64_t t) const {
+                uint32_t m = (uint32_t)t * p_inv_neg;
+                uint32_t r = (uint32_t)((t + (uint64_t)m * p) >> 32);
+                return r >= p ? r - p : r;
+            }
+
+            uint32_t mul(uint32_t a, uint32_t b) const { return reduce((uint64_t)a * b); }
+            uint32_t to_mont(uint32_t a) const { return mul(a, r2); }
+            uint32_t add(uint32_t a, uint32_t b) const { uint32_t r = a + b; return r >= p ? r - p : r; }
+            uint32_t sub(uint32_t a, uint32_t b) const { return a >= b ? a - b : a + p - b; }
+
+            // a 为 Montgomery 形式，结果也为 Montgomery 形式
+            uint32_t pow(uint32_t a, uint64_t e) const {
+                uint32_t r = to_mont(1);
+                for (; e; e >>= 1, a = mul(a, a))
+                    if (e & 1) r = mul(r, a);
+                return r;
+            }
+        };
+
+        struct NTTPrime {
+            uint32_t p;
+            uint32_t g;   // 原根
+            int max_log;  // p - 1 中 2 的幂次
+        };
+
+        // 三个模数之积约 2^90.7，可容纳长度 2^25（NTT_MAX_LENGTH）的 10^9 进制卷积系数
+        const NTTPrime NTT_PRIMES[3] = {
+            {2013265921u, 31, 27},
+            {469762049u, 3, 26},
+            {2113929217u, 5, 25},
+        };
+
+        // roots[len + k] = w_{2len}^k（Montgomery 形式），每层蝶形连续访问；roots 有 n >= 2 个元素
+        void ntt_roots(uint32_t* roots, const Montgomery32& mg, uint32_t g, size_t n, bool inv) {
+            uint32_t w = mg.pow(mg.to_mont(g), (mg.p - 1) / n);
+            if (inv) w = mg.pow(w, mg.p - 2);
+            const size_t half = n / 2;
+            roots[half] = mg.to_mont(1);
+            for (size_t k = 1; k < half; ++k)
+                roots[half + k] = mg.mul(roots[half + k - 1], w);
+            for (size_t len = half / 2; len >= 1; len /= 2)
+                for (size_t k = 0; k < len; ++k)
+                    roots[len + k] = roots[2 * (len + k)];
+        }
+
+        // 每块至少这么多个蝶形才值得交给线程池
+        const size_t NTT_PARALLEL_GRAIN = 1 << 15;
+
+        // 对一层的全部蝶形调用 butterfly(i, k)，i 为组起点、k 为组内下标
+        // 组数多时按组切分交给线程池，组数少时按组内下标切分
+        template <class Butterfly>
+        void ntt_stage(size_t n, size_t len, const Butterfly& butterfly) {
+            const size_t groups = n / (2 * len);
+            if (groups >= len) {
+                parallel_for(0, groups, std::max<size_t>(1, NTT_PARALLEL_GRAIN / len), [&](size_t lo, size_t hi) {
+                    for (size_t g = lo; g < hi; ++g)
+                        for (size_t k = 0; k < len; ++k)
+                            butterfly(2 * len * g, k);
+                });
+            } else {
+                parallel_for(0, len, std::max<size_t>(1, NTT_PARALLEL_GRAIN / groups), [&](size_t lo, size_t hi) {
+                    for (size_t g = 0; g < groups; ++g)
+                        for (size_t k = lo; k < hi; ++k)
+                            butterfly(2 * len * g, k);
+                });
+            }
+        }
+
+        // DIF 正变换：自然序输入，位逆序输出
+        void ntt_forward(uint32_t* data, size_t n, const Montgomery32& mg, const uint32_t* w) {
+            for (size_t len = n / 2; len >= 1; len /= 2) {
+                ntt_stage(n, len, [=](size_t i, size_t k) {
+                    uint32_t u = data[i + k];
+                    uint32_t v = data[i + k + len];
+                    data[i + k] = mg.add(u, v);
+                    data[i + k + len] = mg.mul(mg.sub(u, v), w[len + k]);
+                });
+            }
+        }
+
+        // DIT 逆变换：位逆序输入，自然序输出（未除以 n）
+        void ntt_inverse(uint32_t* data, size_t n, const Montgomery32& mg, const uint32_t* w) {
+            for (size_t len = 1; len < n; len *= 2) {
+                ntt_stage(n, len, [=](size_t i, size_t k) {
+                    uint32_t u = data[i + k];
+                    uint32_t v = mg.mul(data[i + k + len], w[len + k]);
+                    data[i + k] = mg.add(u, v);
+                    data[i + k + len] = mg.sub(u, v);
+                });
+            }
+        }
+
+        // 在一个模数下计算循环卷积，结果为普通（非 Montgomery）形式，写在 fa[0..n)
+        // square 为真时 b 与 a 相同，只做一次正变换，不用 fb；roots 是 n 个元素的单位根表
+        void ntt_convolve(uint32_t* fa, uint32_t* fb, uint32_t* roots, const limb_t* a, size_t na,
+                          const limb_t* b, size_t nb, size_t n, const NTTPrime& prime, bool square) {
+            const Montgomery32 mg(prime.p);
+            std::fill(fa, fa + n, 0);
+            for (size_t i = 0; i < na; ++i) fa[i] = a[i] % prime.p;
+
+            // 数据保持普通形式，与 Montgomery 形式的单位根相乘后仍为普通形式
+            ntt_roots(roots, mg, prime.g, n, false);
+            if (square) {
+                ntt_forward(fa, n, mg, roots);
+                for (size_t i = 0; i < n; ++i)
+                    fa[i] = mg.mul(fa[i], fa[i]); // 多带一个 R^{-1}
+            } else {
+                std::fill(fb, fb + n, 0);
+                for (size_t i = 0; i < nb; ++i) fb[i] = b[i] % prime.p;
+                parallel_invoke({
+                    [=] { ntt_forward(fa, n, mg, roots); },
+                    [=] { ntt_forward(fb, n, mg, roots); },
+                }, std::min(na, nb));
+                for (size_t i = 0; i < n; ++i)
+                    fa[i] = mg.mul(fa[i], fb[i]); // 多带一个 R^{-1}
+            }
+
+            ntt_roots(roots, mg, prime.g, n, true);
+            ntt_inverse(fa, n, mg, roots);
+
+            // 乘以 R^2 * n^{-1} 同时抵消 R^{-1} 和长度因子
+            uint32_t n_inv = mg.pow(mg.to_mont((uint32_t)(n % prime.p)), prime.p - 2);
+            uint32_t scale = mg.to_mont(n_inv);
+            for (size_t i = 0; i < n; ++i)
+                fa[i] = mg.mul(fa[i], scale);
+        }
+
+        uint32_t inverse_mod(uint64_t a, uint32_t p) {
+            uint64_t r = 1, e = p - 2;
+            a %= p;
+            for (; e; e >>= 1, a = a * a % p)
+                if (e & 1) r = r * a % p;
+            return (uint32_t)r;
+        }
+
+        void ntt_split(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb);
+    }
+
+    void ntt_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        BIGINTEGER_STAT(NTT, std::min(na, nb));
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        const size_t len = na + nb;
+        if (len > std::min(thresholds().ntt_max, NTT_MAX_LENGTH)) {
+            ntt_split(out, a, na, b, nb);
+            return;
+        }
+        if (nb == 0) {
+            std::fill(out, out + len, 0);
+            return;
+        }
+        size_t n = 1;
+        while (n < len) {
+            n *= 2;
+        }
+
+        const bool square = na == nb && (a == b || std::equal(a, a + na, b));
+        // 三个模数下的卷积互相独立；各自的两个变换缓冲与单位根表一次从 ScratchFrame 取出
+        const size_t per_prime = (square ? 2 : 3) * n;
+        ScratchFrame frame;
+        uint32_t* buffers = frame.limbs(3 * per_prime);
+        uint32_t* r[3];
+        std::vector<std::function<void()>> convolutions;
+        for (int k = 0; k < 3; ++k) {
+            r[k] = buffers + k * per_prime;
+            uint32_t* fb = r[k] + n;
+            uint32_t* roots = square ? r[k] + n : r[k] + 2 * n;
+            convolutions.push_back([=, &r] { ntt_convolve(r[k], fb, roots, a, na, b, nb, n, NTT_PRIMES[k], square); });
+        }
+        parallel_invoke(convolutions, len / 2);
+
+        // Garner 中国剩余定理：x = r0 + p0 * t1 + p0 * p1 * t2
+        const uint64_t p0 = NTT_PRIMES[0].p, p1 = NTT_PRIMES[1].p, p2 = NTT_PRIMES[2].p;
+        const uint64_t inv_p0_mod_p1 = inverse_mod(p0, p1);
+        const uint64_t inv_p0p1_mod_p2 = inverse_mod(p0 * p1 % p2, p2);
+
+        unsigned __int128 carry = 0;
+        for (size_t i = 0; i < len; ++i) {
+            uint64_t r0 = r[0][i], r1 = r[1][i], r2 = r[2][i];
+            uint64_t t1 = (r1 + p1 - r0 % p1) % p1 * inv_p0_mod_p1 % p1;
+            uint64_t x01 = r0 + p0 * t1; // < p0 * p1 < 2^62
+            uint64_t t2 = (r2 + p2 - x01 % p2) % p2 * inv_p0p1_mod_p2 % p2;
+            carry += (unsigned __int128)(p0 * p1) * t2 + x01;
+            out[i] = (limb_t)(carry % BASE);
+            carry /= BASE;
+        }
+    }
+
+    namespace {
+
+        // 总长超过单次变换上限的乘积，na >= nb：长度悬殊时把长的切成与短的等长的段，段积原地加到 out 上；
+        // 否则做一层 Karatsuba，z0、z2 直接写进 out，z1 和两个和式取自 ScratchFrame，仍超限的子乘积继续拆
+        void ntt_split(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+            ScratchFrame frame;
+            if (na >= 2 * nb) {
+                std::fill(out, out + na + nb, 0);
+                limb_t* p = frame.limbs(2 * nb);
+                for (size_t i = 0; i < na; i += nb) {
+                    const size_t c = std::min(nb, na - i);
+                    ntt_limbs(p, a + i, c, b, nb);
+                    add_limbs(out + i, out + i, c + nb, p, c + nb);
+                }
+                return;
+            }
+
+            // na < 2 nb，所以 b 的低半段也是满的 m 个 limb，高半段 hb 不超过 h
+            const size_t m = (na + 1) / 2, h = na - m, hb = nb - m;
+            limb_t* sa = frame.limbs(4 * m + 4);
+            limb_t* sb = sa + (m + 1);
+            limb_t* z1 = sb + (m + 1);
+            sa[m] = add_limbs(sa, a, m, a + m, h);
+            sb[m] = add_limbs(sb, b, m, b + m, hb);
+            // 和式去掉前导零再相乘，否则上限很低时 (m + 1) × (m + 1) 的子乘积可能拆不下去
+            const size_t lz = 2 * m + 2;
+            const size_t la = trimmed_length(sa, m + 1), lb = trimmed_length(sb, m + 1);
+            std::fill(z1 + la + lb, z1 + lz, 0);
+            parallel_invoke({
+                [=] { ntt_limbs(out, a, m, b, m); },
+                [=] { ntt_limbs(out + 2 * m, a + m, h, b + m, hb); },
+                [=] { ntt_limbs(z1, sa, la, sb, lb); },
+            }, m);
+
+            // z1 = (a0 + a1)(b0 + b1) - z0 - z2 = a0 b1 + a1 b0，再加到 out 的中段
+            sub_limbs(z1, z1, lz, out, 2 * m);
+            sub_limbs(z1, z1, lz, out + 2 * m, h + hb);
+            add_limbs(out + m, out + m, na + nb - m, z1, trimmed_length(z1, lz));
+        }
+    }
+
+    BigInteger NTT_multiply(const BigInteger& a, const BigInteger& b) {
+        if (is_zero(a) || is_zero(b)) {
+            return from_longlong(0);
+        }
+
+        BigInteger result;
+        result.digits.resize(a.digits.size() + b.digits.size());
+        ntt_limbs(result.digits.data(), a.digits.data(), a.digits.size(), b.digits.data(), b.digits.size());
+        remove_leading_zeros(result);
+        result.is_negative = a.is_negative != b.is_negative;
+        return result;
+    }
+}
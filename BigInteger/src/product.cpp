@@ -0,0 +1,135 @@
+#include <BigInteger/biginteger.h>
+
+#include <bit>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 子树的总长不超过该 limb 数时顺序连乘，很小的乘积不必再建树
+        const size_t PRODUCT_LEAF_LIMBS = 16;
+
+        // [lo, hi) 的乘积，prefix[i] 为前 i 个数的总 limb 数。
+        // 按长度而不是个数对半分，两棵子树的乘积长度相近，每次乘法都落在快速乘法的平衡区间
+        BigInteger product_range(std::span<const BigInteger> nums, const std::vector<size_t>& prefix, size_t lo, size_t hi) {
+            if (hi - lo == 1) return nums[lo];
+            const size_t limbs = prefix[hi] - prefix[lo];
+            if (limbs <= PRODUCT_LEAF_LIMBS) {
+                BigInteger result = nums[lo];
+                for (size_t i = lo + 1; i < hi; ++i) result *= nums[i];
+                return result;
+            }
+
+            size_t mid = std::upper_bound(prefix.begin() + lo + 1, prefix.begin() + hi, prefix[lo] + limbs / 2) - prefix.begin();
+            mid = std::clamp(mid, lo + 1, hi - 1);
+            BigInteger left, right;
+            parallel_invoke({
+                [&] { left = product_range(nums, prefix, lo, mid); },
+                [&] { right = product_range(nums, prefix, mid, hi); },
+            }, std::min(prefix[mid] - prefix[lo], prefix[hi] - prefix[mid]));
+            return left * right;
+        }
+
+        // 把小因子连乘进机器字，乘积即将超过 2^63 时换下一个
+        std::vector<BigInteger> pack(const std::vector<uint64_t>& factors) {
+            std::vector<BigInteger> packed;
+            uint64_t acc = 1;
+            for (uint64_t f : factors) {
+                if (acc > (uint64_t)std::numeric_limits<int64_t>::max() / f) {
+                    packed.push_back(from_longlong((long long)acc));
+                    acc = 1;
+                }
+                acc *= f;
+            }
+            packed.push_back(from_longlong((long long)acc));
+            return packed;
+        }
+
+        // 不超过 n 的素数，只筛奇数
+        std::vector<uint64_t> primes_up_to(uint64_t n) {
+            std::vector<uint64_t> primes;
+            if (n < 2) return primes;
+            primes.push_back(2);
+            std::vector<bool> composite(n / 2 + 1); // 下标 i 对应 2i + 1
+            for (uint64_t i = 1; 2 * i + 1 <= n; ++i) {
+                if (composite[i]) continue;
+                const uint64_t p = 2 * i + 1;
+                primes.push_back(p);
+                if (p <= n / p)
+                    for (uint64_t j = p * p / 2; j <= n / 2; j += p) composite[j] = true;
+            }
+            return primes;
+        }
+
+        // n! 中 p 的指数（Legendre）
+        uint64_t legendre(uint64_t n, uint64_t p) {
+            uint64_t e = 0;
+            while (n) {
+                n /= p;
+                e += n;
+            }
+            return e;
+        }
+
+        // ∏ p^e(p)：按指数的二进制位从高到低，result = result² · ∏{该位为 1 的 p}，
+        // 大的乘法都是平方或平衡的乘积树
+        BigInteger prime_power_product(const std::vector<uint64_t>& primes, const std::vector<uint64_t>& exponents) {
+            uint64_t top = 0;
+            for (uint64_t e : exponents) top = std::max(top, e);
+
+            BigInteger result = from_longlong(1);
+            for (size_t bit = std::bit_width(top); bit-- > 0;) {
+                std::vector<uint64_t> chosen;
+                for (size_t i = 0; i < primes.size(); ++i)
+                    if ((exponents[i] >> bit) & 1) chosen.push_back(primes[i]);
+                result = result * result;
+                if (!chosen.empty()) result *= product(pack(chosen));
+            }
+            return result;
+        }
+    }
+
+    BigInteger product(std::span<const BigInteger> nums) {
+        if (nums.empty()) return from_longlong(1);
+        std::vector<size_t> prefix(nums.size() + 1, 0);
+        for (size_t i = 0; i < nums.size(); ++i) prefix[i + 1] = prefix[i] + nums[i].digits.size();
+        BIGINTEGER_STAT(Product, prefix.back());
+        return product_range(nums, prefix, 0, nums.size());
+    }
+
+    BigInteger factorial(int64_t n) {
+        if (n < 0) {
+            throw std::invalid_argument("Factorial of negative number");
+        }
+        const std::vector<uint64_t> primes = primes_up_to(n);
+        std::vector<uint64_t> exponents(primes.size());
+        for (size_t i = 0; i < primes.size(); ++i) exponents[i] = legendre(n, primes[i]);
+        return prime_power_product(primes, exponents);
+    }
+
+    // k 不在 [0, n] 内时为 0
+    BigInteger binomial(int64_t n, int64_t k) {
+        if (n < 0) {
+            throw std::invalid_argument("Binomial of negative number");
+        }
+        if (k < 0 || k > n) return from_longlong(0);
+        k = std::min(k, n - k);
+
+        const std::vector<uint64_t> all = primes_up_to(n);
+        std::vector<uint64_t> primes, exponents;
+        for (uint64_t p : all) {
+            const uint64_t e = legendre(n, p) - legendre(k, p) - legendre(n - k, p);
+            if (e == 0) continue;
+            primes.push_back(p);
+            exponents.push_back(e);
+        }
+        return prime_power_product(primes, exponents);
+    }
+
+    BigInteger primorial(int64_t n) {
+        if (n < 0) {
+            throw std::invalid_argument("Primorial of negative number");
+        }
+        return product(pack(primes_up_to(n)));
+    }
+}
@@ -0,0 +1,173 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 根不超过该 limb 数时直接用带除法的整数 Newton 迭代
+        const size_t ROOT_BASECASE = 16;
+
+        BigInteger power(BigInteger x, int64_t e) {
+            BigInteger result = from_longlong(1);
+            for (; e > 0; e >>= 1) {
+                if (e & 1) result *= x;
+                if (e > 1) x = x * x;
+            }
+            return result;
+        }
+
+        // 右移 n 个 limb，向零截断并保留符号
+        BigInteger upper_signed(const BigInteger& num, size_t n) {
+            BigInteger result = upper(num, n);
+            result.is_negative = num.is_negative && !is_zero(result);
+            return result;
+        }
+
+        // y ← ((k-1) y + N / y^(k-1)) / k。对任意正的 y，结果都不小于 floor(N^(1/k))（算术-几何平均不等式）
+        BigInteger newton_step(const BigInteger& num, const BigInteger& y, int64_t k) {
+            BigInteger next = y * (k - 1) + num / power(y, k - 1);
+            divmod_small(next, k);
+            return next;
+        }
+
+        // floor(N^(1/k))，N > 0：用 long double 由最高几个 limb 估计初值，之后整数 Newton 从上方单调下降，
+        // 不再下降时即为所求
+        BigInteger root_newton(const BigInteger& num, int64_t k) {
+            const size_t n = num.digits.size(), used = std::min<size_t>(n, 3);
+            long double top = 0;
+            for (size_t i = 0; i < used; ++i) top = top * BASE + num.digits[n - 1 - i];
+            const long double log_base = std::log((long double)BASE);
+            const long double e = (std::log(top) + (n - used) * log_base) / (k * log_base); // 根以 BASE 为底的对数
+            const size_t shift = e > 2 ? (size_t)e - 1 : 0;
+            BigInteger y = shift_left(from_longlong((long long)std::pow((long double)BASE, e - shift) + 1), shift);
+
+            y = newton_step(num, y, k); // 初值偏小时第一步也会越到根的上方
+            while (true) {
+                BigInteger next = newton_step(num, y, k);
+                if (compare_abs(next, y) >= 0) return y;
+                y = std::move(next);
+            }
+        }
+
+        // 近似 BASE^(2k) / sqrt(N)，误差只有几个单位；要求 BASE^(2k-2) <= N < BASE^(2k)。
+        // 高 2h 个 limb 的结果按 BASE^(k-h) 放大作初值，再做一次不含除法的 Newton：x += x (1 - N x²) / 2
+        BigInteger inverse_sqrt(const BigInteger& num, size_t k) {
+            if (k <= ROOT_BASECASE) return root_newton(power_of_base(4 * k) / num, 2);
+
+            const size_t h = k / 2 + 2;
+            const BigInteger xh = inverse_sqrt(upper(num, 2 * (k - h)), h);
+
+            // e = BASE^(2k+2h) - N xh²，只要到 BASE^(k+2h-1) 这一位，所以 N 只取高 k + 4 个 limb；
+            // 修正量 xh e / (2 BASE^(k+3h)) 再由 e 的高位和 xh 相乘得到
+            const BigInteger e = power_of_base(2 * k + 2 * h) - shift_left(upper(num, k - 4) * (xh * xh), k - 4);
+            BigInteger correction = upper_signed(xh * upper_signed(e, k + 2 * h - 1), h + 1);
+            divmod_small(correction, 2);
+            return shift_left(xh, k - h) + correction;
+        }
+
+        // floor(sqrt(N))，误差在 ±2 以内，由调用方用余数修正。
+        // 高半部分的倒数平方根 xh 给出 s0 ≈ sqrt(N) 的一半精度，再用 s = s0 + xh (N - s0²) / 2 一步补足
+        // （Karp–Markstein），整个过程只有乘法，代价是目标长度下几次乘法
+        BigInteger sqrt_approx(const BigInteger& num) {
+            const size_t k = (num.digits.size() + 1) / 2;
+            if (k <= ROOT_BASECASE) return root_newton(num, 2);
+
+            const size_t h = k / 2 + 2;
+            const BigInteger top = upper(num, 2 * (k - h));
+            const BigInteger xh = inverse_sqrt(top, h);
+            const BigInteger s0 = upper(upper(top, h - 1) * xh, h + 1);
+
+            const BigInteger d = num - shift_left(s0 * s0, 2 * (k - h));
+            BigInteger correction = upper_signed(upper_signed(d, k - 1) * xh, h + 1);
+            divmod_small(correction, 2);
+            return shift_left(s0, k - h) + correction;
+        }
+
+        // floor(N^(1/k)) 或比它大一点，k >= 3，N > 0。
+        // 高位部分的根加一再放大 BASE^j 是根的上界，从它出发一步 Newton 精度翻倍且仍不小于根
+        BigInteger root_approx(const BigInteger& num, int64_t k) {
+            const size_t n = num.digits.size();
+            const size_t m = (n + k - 1) / k; // 根的 limb 数上界
+            if (m <= ROOT_BASECASE) return root_newton(num, k);
+
+            const size_t j = m / 2 - 2;
+            const BigInteger yh = root_approx(upper(num, k * j), k) + 1;
+
+            // y = yh BASE^j，y^(k-1) 的低 j (k-1) 个 limb 都是零，直接从 N 中移去
+            BigInteger next = shift_left(yh * (k - 1), j) + upper(num, j * (k - 1)) / power(yh, k - 1);
+            divmod_small(next, k);
+            return next;
+        }
+    }
+
+    BigInteger isqrt(const BigInteger& num, BigInteger& remainder) {
+        BIGINTEGER_STAT(Sqrt, num.digits.size());
+        if (num.is_negative) {
+            throw std::invalid_argument("Square root of negative number");
+        }
+        if (is_zero(num)) {
+            remainder = from_longlong(0);
+            return from_longlong(0);
+        }
+
+        BigInteger s = sqrt_approx(num);
+        remainder = num - s * s;
+        // (s + 1)² - s² = 2s + 1
+        while (remainder.is_negative) {
+            sub_small(s, 1);
+            remainder += s * 2 + 1;
+        }
+        while (compare_abs(remainder, s * 2) > 0) {
+            remainder -= s * 2 + 1;
+            add_small(s, 1);
+        }
+        return s;
+    }
+
+    BigInteger isqrt(const BigInteger& num) {
+        BigInteger remainder;
+        return isqrt(num, remainder);
+    }
+
+    // 负数的奇次方根向零截断，余数与 num 同号
+    BigInteger iroot(const BigInteger& num, int64_t k, BigInteger& remainder) {
+        if (k <= 0) {
+            throw std::invalid_argument("Root degree must be positive");
+        }
+        if (num.is_negative && k % 2 == 0) {
+            throw std::invalid_argument("Even root of negative number");
+        }
+        if (k == 1 || is_zero(num)) {
+            remainder = from_longlong(0);
+            return num;
+        }
+        if (k == 2) return isqrt(num, remainder);
+
+        BIGINTEGER_STAT(Root, num.digits.size());
+        const BigInteger a = absolute(num);
+        BigInteger y, p;
+        // BASE < 2^30，k 不小于 30 倍 limb 数时 2^k > |num|，根只能是 1
+        if ((uint64_t)k >= 30 * (uint64_t)a.digits.size()) {
+            y = from_longlong(1);
+            p = y;
+        } else {
+            y = root_approx(a, k);
+            p = power(y, k);
+            while (compare_abs(p, a) > 0) {
+                sub_small(y, 1);
+                p = power(y, k);
+            }
+        }
+        remainder = a - p;
+        if (num.is_negative) {
+            y = negate(std::move(y));
+            remainder = negate(std::move(remainder));
+        }
+        return y;
+    }
+
+    BigInteger iroot(const BigInteger& num, int64_t k) {
+        BigInteger remainder;
+        return iroot(num, k, remainder);
+    }
+}
@@ -0,0 +1,68 @@
+#include <BigInteger/biginteger.h>
+
+#include <memory>
+
+namespace Biginteger{
+
+    namespace {
+
+        struct ScratchBlock {
+            std::unique_ptr<unsigned char[]> data;
+            size_t size = 0; // 字节数
+        };
+
+        // 每个线程一串缓冲块，当前位置为 (block, used)；ScratchFrame 记下进入时的位置，析构时退回
+        struct ScratchArena {
+            std::vector<ScratchBlock> blocks;
+            size_t block = 0;
+            size_t used = 0;
+        };
+
+        const size_t MIN_BLOCK_BYTES = 1 << 18;
+
+        thread_local ScratchArena arena;
+
+        void* take(size_t bytes) {
+            bytes = (bytes + 15) & ~(size_t)15; // 保持 16 字节对齐
+            if (arena.block < arena.blocks.size() && arena.used + bytes <= arena.blocks[arena.block].size) {
+                void* p = arena.blocks[arena.block].data.get() + arena.used;
+                arena.used += bytes;
+                return p;
+            }
+
+            // 当前块放不下就换到下一块；它之后的块都没有活跃的分配，太小可以直接换成更大的
+            const size_t next = arena.used == 0 ? arena.block : arena.block + 1;
+            if (next == arena.blocks.size()) arena.blocks.emplace_back();
+            ScratchBlock& target = arena.blocks[next];
+            if (target.size < bytes) {
+                size_t size = std::max(bytes, MIN_BLOCK_BYTES);
+                if (next > 0) size = std::max(size, 2 * arena.blocks[next - 1].size);
+                BIGINTEGER_STAT_ALLOC(size);
+                target.data = std::make_unique<unsigned char[]>(size);
+                target.size = size;
+            }
+            arena.block = next;
+            arena.used = bytes;
+            return target.data.get();
+        }
+    }
+
+    ScratchFrame::ScratchFrame() : block(arena.block), used(arena.used) {}
+
+    ScratchFrame::~ScratchFrame() {
+        arena.block = block;
+        arena.used = used;
+    }
+
+    limb_t* ScratchFrame::limbs(size_t n) {
+        return static_cast<limb_t*>(take(n * sizeof(limb_t)));
+    }
+
+    uint64_t* ScratchFrame::words(size_t n) {
+        return static_cast<uint64_t*>(take(n * sizeof(uint64_t)));
+    }
+
+    std::complex<double>* ScratchFrame::complexes(size_t n) {
+        return static_cast<std::complex<double>*>(take(n * sizeof(std::complex<double>)));
+    }
+}
@@ -0,0 +1,321 @@
+#include <BigInteger/biginteger.h>
+
+#include <atomic>
+#include <cstring>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 每种指令集各一套内核，只在各自的函数上打开 target，库本身按基础 x86-64 编译
+
+        // 进位超前：每个 lane 的进位产生掩码 g（和 >= BASE）与传递掩码 p（和 == BASE-1）互斥，
+        // 进入各 lane 的进位为 ((g << 1 | cin) + p) ^ p，最高位之上的一位就是整块的进位输出。
+        // 减法同理，g 为差 < 0，p 为差 == 0。
+        inline uint32_t resolve_carries(uint32_t g, uint32_t p, uint32_t cin) {
+            uint32_t a = (g << 1) | cin;
+            return (a + p) ^ p;
+        }
+
+        // out[i] = x[i] + y[i] + 进位，i < m，返回最高位的进位；out 可以与 x 或 y 相同
+        limb_t add_limbs_scalar(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t carry) {
+            for (size_t i = 0; i < m; ++i) {
+                limb_t sum = x[i] + y[i] + carry;
+                carry = sum >= BASE;
+                out[i] = carry ? sum - BASE : sum;
+            }
+            return carry;
+        }
+
+        limb_t sub_limbs_scalar(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t borrow) {
+            for (size_t i = 0; i < m; ++i) {
+                limb_t diff = x[i] - y[i] - borrow;
+                borrow = x[i] < (uint64_t)y[i] + borrow;
+                out[i] = borrow ? diff + BASE : diff;
+            }
+            return borrow;
+        }
+
+        __attribute__((target("avx2")))
+        limb_t add_limbs_avx2(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t carry) {
+            const __m256i base_m1 = _mm256_set1_epi32(BASE - 1);
+            const __m256i base = _mm256_set1_epi32(BASE);
+            const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            size_t i = 0;
+            for (; i + 8 <= m; i += 8) {
+                // 和小于 2*10^9 < 2^31，有符号比较即可
+                __m256i s = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(x + i)),
+                                             _mm256_loadu_si256((const __m256i*)(y + i)));
+                uint32_t g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, base_m1)));
+                uint32_t p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(s, base_m1)));
+                uint32_t c = resolve_carries(g, p, carry);
+                carry = (c >> 8) & 1;
+                // 把进位掩码展开成每 lane 的 -1/0，减去即加一
+                __m256i vc = _mm256_and_si256(_mm256_set1_epi32((int)c), lane_bits);
+                s = _mm256_sub_epi32(s, _mm256_cmpeq_epi32(vc, lane_bits));
+                s = _mm256_sub_epi32(s, _mm256_and_si256(_mm256_cmpgt_epi32(s, base_m1), base));
+                _mm256_storeu_si256((__m256i*)(out + i), s);
+            }
+            return add_limbs_scalar(out + i, x + i, y + i, m - i, carry);
+        }
+
+        __attribute__((target("avx2")))
+        limb_t sub_limbs_avx2(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t borrow) {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i base = _mm256_set1_epi32(BASE);
+            const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            size_t i = 0;
+            for (; i + 8 <= m; i += 8) {
+                // 差在 (-10^9, 10^9) 之间，按有符号数处理
+                __m256i d = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(x + i)),
+                                             _mm256_loadu_si256((const __m256i*)(y + i)));
+                uint32_t g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, d)));
+                uint32_t p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(d, zero)));
+                uint32_t c = resolve_carries(g, p, borrow);
+                borrow = (c >> 8) & 1;
+                __m256i vc = _mm256_and_si256(_mm256_set1_epi32((int)c), lane_bits);
+                d = _mm256_add_epi32(d, _mm256_cmpeq_epi32(vc, lane_bits));
+                d = _mm256_add_epi32(d, _mm256_and_si256(_mm256_cmpgt_epi32(zero, d), base));
+                _mm256_storeu_si256((__m256i*)(out + i), d);
+            }
+            return sub_limbs_scalar(out + i, x + i, y + i, m - i, borrow);
+        }
+
+        __attribute__((target("avx512f")))
+        limb_t add_limbs_avx512(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t carry) {
+            const __m512i base_m1 = _mm512_set1_epi32(BASE - 1);
+            const __m512i base = _mm512_set1_epi32(BASE);
+            const __m512i one = _mm512_set1_epi32(1);
+            size_t i = 0;
+            for (; i + 16 <= m; i += 16) {
+                __m512i s = _mm512_add_epi32(_mm512_loadu_si512((const __m512i*)(x + i)),
+                                             _mm512_loadu_si512((const __m512i*)(y + i)));
+                uint32_t g = _mm512_cmpgt_epu32_mask(s, base_m1);
+                uint32_t p = _mm512_cmpeq_epi32_mask(s, base_m1);
+                uint32_t c = resolve_carries(g, p, carry);
+                carry = (c >> 16) & 1;
+                s = _mm512_mask_add_epi32(s, (__mmask16)c, s, one);
+                s = _mm512_mask_sub_epi32(s, _mm512_cmpgt_epu32_mask(s, base_m1), s, base);
+                _mm512_storeu_si512((__m512i*)(out + i), s);
+            }
+            return add_limbs_scalar(out + i, x + i, y + i, m - i, carry);
+        }
+
+        __attribute__((target("avx512f")))
+        limb_t sub_limbs_avx512(limb_t* out, const limb_t* x, const limb_t* y, size_t m, limb_t borrow) {
+            const __m512i zero = _mm512_setzero_si512();
+            const __m512i base = _mm512_set1_epi32(BASE);
+            const __m512i one = _mm512_set1_epi32(1);
+            size_t i = 0;
+            for (; i + 16 <= m; i += 16) {
+                __m512i d = _mm512_sub_epi32(_mm512_loadu_si512((const __m512i*)(x + i)),
+                                             _mm512_loadu_si512((const __m512i*)(y + i)));
+                uint32_t g = _mm512_cmplt_epi32_mask(d, zero);
+                uint32_t p = _mm512_cmpeq_epi32_mask(d, zero);
+                uint32_t c = resolve_carries(g, p, borrow);
+                borrow = (c >> 16) & 1;
+                d = _mm512_mask_sub_epi32(d, (__mmask16)c, d, one);
+                d = _mm512_mask_add_epi32(d, _mm512_cmplt_epi32_mask(d, zero), d, base);
+                _mm512_storeu_si512((__m512i*)(out + i), d);
+            }
+            return sub_limbs_scalar(out + i, x + i, y + i, m - i, borrow);
+        }
+
+        // acc[j] += ai * b[j]，j < m；乘积小于 10^18，由调用方定期归一化
+        void mul_row_scalar(uint64_t* acc, uint64_t ai, const limb_t* b, size_t m) {
+            for (size_t j = 0; j < m; ++j)
+                acc[j] += ai * b[j];
+        }
+
+        __attribute__((target("avx2")))
+        void mul_row_avx2(uint64_t* acc, uint64_t ai, const limb_t* b, size_t m) {
+            const __m256i va = _mm256_set1_epi64x((long long)ai);
+            size_t j = 0;
+            for (; j + 4 <= m; j += 4) {
+                __m256i vb = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(b + j)));
+                __m256i res = _mm256_loadu_si256((const __m256i*)(acc + j));
+                res = _mm256_add_epi64(res, _mm256_mul_epu32(va, vb));
+                _mm256_storeu_si256((__m256i*)(acc + j), res);
+            }
+            for (; j < m; ++j)
+                acc[j] += ai * b[j];
+        }
+
+        __attribute__((target("avx512f")))
+        void mul_row_avx512(uint64_t* acc, uint64_t ai, const limb_t* b, size_t m) {
+            const __m512i va = _mm512_set1_epi64((long long)ai);
+            size_t j = 0;
+            // 全选的零掩码形式与不带掩码的结果相同；GCC 12 的不带掩码版本以未初始化的向量作源，-Wall 下会报警
+            const __mmask8 all = 0xFF;
+            for (; j + 8 <= m; j += 8) {
+                __m512i vb = _mm512_maskz_cvtepu32_epi64(all, _mm256_loadu_si256((const __m256i*)(b + j)));
+                __m512i res = _mm512_loadu_si512((const __m512i*)(acc + j));
+                res = _mm512_add_epi64(res, _mm512_maskz_mul_epu32(all, va, vb));
+                _mm512_storeu_si512((__m512i*)(acc + j), res);
+            }
+            for (; j < m; ++j)
+                acc[j] += ai * b[j];
+        }
+
+        struct SimdKernels {
+            SimdLevel level;
+            limb_t (*add_limbs)(limb_t*, const limb_t*, const limb_t*, size_t, limb_t);
+            limb_t (*sub_limbs)(limb_t*, const limb_t*, const limb_t*, size_t, limb_t);
+            void (*mul_row)(uint64_t*, uint64_t, const limb_t*, size_t);
+        };
+
+        const SimdKernels KERNELS[] = {
+            {SimdLevel::Scalar, add_limbs_scalar, sub_limbs_scalar, mul_row_scalar},
+            {SimdLevel::AVX2, add_limbs_avx2, sub_limbs_avx2, mul_row_avx2},
+            {SimdLevel::AVX512, add_limbs_avx512, sub_limbs_avx512, mul_row_avx512},
+        };
+
+        SimdLevel detected_level() {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+            return SimdLevel::Scalar;
+        }
+
+        // 默认取 CPU 支持的最高级别；BIGINTEGER_SIMD=avx512|avx2|scalar 可以改低，但不会超过 CPU 支持的级别
+        SimdLevel initial_level() {
+            const SimdLevel cpu = detected_level();
+            const char* env = std::getenv("BIGINTEGER_SIMD");
+            if (!env) return cpu;
+            for (const auto& k : KERNELS) {
+                if (std::strcmp(env, simd_level_name(k.level)) != 0) continue;
+                if (k.level > cpu) {
+                    std::cerr << "BIGINTEGER_SIMD: " << env << " is not supported by this CPU, using "
+                              << simd_level_name(cpu) << "\n";
+                    return cpu;
+                }
+                return k.level;
+            }
+            std::cerr << "BIGINTEGER_SIMD: unknown level '" << env << "', using " << simd_level_name(cpu) << "\n";
+            return cpu;
+        }
+
+        std::atomic<const SimdKernels*>& active_kernels() {
+            static std::atomic<const SimdKernels*> kernels{&KERNELS[(int)initial_level()]};
+            return kernels;
+        }
+
+        const SimdKernels& kernels() {
+            return *active_kernels().load(std::memory_order_relaxed);
+        }
+
+        // 将 64 位累加器 [from, to) 归一化为 10^9 进制
+        void normalize_acc(uint64_t* acc, size_t from, size_t to) {
+            uint64_t carry = 0;
+            for (size_t k = from; k < to; ++k) {
+                uint64_t cur = acc[k] + carry;
+                acc[k] = cur % BASE;
+                carry = cur / BASE;
+            }
+        }
+    }
+
+    const char* simd_level_name(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX512: return "avx512";
+            case SimdLevel::AVX2: return "avx2";
+            default: return "scalar";
+        }
+    }
+
+    SimdLevel simd_level() {
+        return kernels().level;
+    }
+
+    SimdLevel cpu_simd_level() {
+        static const SimdLevel level = detected_level();
+        return level;
+    }
+
+    void set_simd_level(SimdLevel level) {
+        if (level > cpu_simd_level())
+            throw std::invalid_argument(std::string("set_simd_level: ") + simd_level_name(level) + " is not supported by this CPU");
+        active_kernels().store(&KERNELS[(int)level], std::memory_order_relaxed);
+    }
+
+    limb_t add_limbs(limb_t* out, const limb_t* x, size_t nx, const limb_t* y, size_t ny) {
+        limb_t carry = kernels().add_limbs(out, x, y, ny, 0);
+        // 较长操作数的其余部分只需传播进位，进位消失后直接复制
+        size_t i = ny;
+        for (; carry && i < nx; ++i) {
+            carry = x[i] == BASE - 1;
+            out[i] = carry ? 0 : x[i] + 1;
+        }
+        if (out != x) std::copy(x + i, x + nx, out + i);
+        return carry;
+    }
+
+    limb_t sub_limbs(limb_t* out, const limb_t* x, size_t nx, const limb_t* y, size_t ny) {
+        limb_t borrow = kernels().sub_limbs(out, x, y, ny, 0);
+        size_t i = ny;
+        for (; borrow && i < nx; ++i) {
+            borrow = x[i] == 0;
+            out[i] = borrow ? BASE - 1 : x[i] - 1;
+        }
+        if (out != x) std::copy(x + i, x + nx, out + i);
+        return borrow;
+    }
+
+    void add_with_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b) {
+        result = add_abs(a, b);
+    }
+
+    void multiply_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        BIGINTEGER_STAT(Schoolbook, std::min(na, nb));
+        // 逐行遍历较短的一方：每次归一化都要扫到末尾，行数少时这部分开销才是线性的
+        if (na > nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        ScratchFrame frame;
+        uint64_t* acc = frame.words(na + nb);
+        std::fill(acc, acc + na + nb, 0);
+        const auto mul_row = kernels().mul_row;
+
+        // 每个乘积小于 10^18，累加 16 行后必须归一化一次以免 64 位溢出
+        const size_t rows_per_normalize = 16;
+        for (size_t i = 0; i < na; ++i) {
+            mul_row(acc + i, a[i], b, nb);
+            if (i % rows_per_normalize == rows_per_normalize - 1)
+                normalize_acc(acc, i + 1 - rows_per_normalize, na + nb);
+        }
+        normalize_acc(acc, 0, na + nb);
+        std::copy(acc, acc + na + nb, out);
+    }
+
+    void redc_limbs(limb_t* out, const limb_t* t, size_t nt, const limb_t* m, size_t n, limb_t inv) {
+        ScratchFrame frame;
+        uint64_t* acc = frame.words(2 * n + 1);
+        std::copy(t, t + nt, acc);
+        std::fill(acc + nt, acc + 2 * n + 1, 0);
+        const auto mul_row = kernels().mul_row;
+
+        // 第 i 行选 u 使 acc[i] 成为 BASE 的倍数，再把它的进位移到 acc[i + 1]；归一化节奏同竖式乘法
+        const size_t rows_per_normalize = 16;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t u = acc[i] % BASE * inv % BASE;
+            mul_row(acc + i, u, m, n);
+            acc[i + 1] += acc[i] / BASE;
+            if (i % rows_per_normalize == rows_per_normalize - 1)
+                normalize_acc(acc, i + 1, 2 * n + 1);
+        }
+        normalize_acc(acc, n, 2 * n + 1);
+        std::copy(acc + n, acc + 2 * n + 1, out);
+    }
+
+    void multiply_avx512(BigInteger& result, const BigInteger& a, const BigInteger& b) {
+        const size_t n = a.digits.size();
+        const size_t m = b.digits.size();
+        // 先算进临时缓冲区，result 可以是 a 或 b 本身
+        ScratchFrame frame;
+        limb_t* out = frame.limbs(n + m);
+        multiply_limbs(out, a.digits.data(), n, b.digits.data(), m);
+        result.digits.assign(out, out + n + m);
+        remove_leading_zeros(result);
+    }
+}
@@ -0,0 +1,261 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        uint64_t magnitude(int64_t k) {
+            return k < 0 ? 0 - (uint64_t)k : (uint64_t)k;
+        }
+
+        // out = in * m + c（幅值），out 可以与 in 是同一个 vector
+        // m < 2^64 最多拆成三个 limb，每步累加值不超过 1.2e19，仍在 uint64_t 内
+        void mul_add_limbs(LimbVector& out, const LimbVector& in, uint64_t m, uint64_t c) {
+            BIGINTEGER_STAT(SmallMul, in.size());
+            const size_t n = in.size();
+            uint64_t carry = c;
+            if (m < BASE) {
+                out.resize(n);
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t cur = (uint64_t)in[i] * m + carry;
+                    out[i] = (limb_t)(cur % BASE);
+                    carry = cur / BASE;
+                }
+            } else {
+                const uint64_t m0 = m % BASE, m1 = m / BASE % BASE, m2 = m / BASE / BASE;
+                out.resize(n + 2);
+                uint64_t prev1 = 0, prev2 = 0; // in[i-1]、in[i-2]，原地计算时已被覆盖
+                for (size_t i = 0; i < n + 2; ++i) {
+                    uint64_t x = i < n ? in[i] : 0;
+                    uint64_t cur = x * m0 + prev1 * m1 + prev2 * m2 + carry;
+                    out[i] = (limb_t)(cur % BASE);
+                    carry = cur / BASE;
+                    prev2 = prev1;
+                    prev1 = x;
+                }
+            }
+            while (carry) {
+                out.push_back((limb_t)(carry % BASE));
+                carry /= BASE;
+            }
+        }
+
+        uint64_t mod_limbs(const LimbVector& digits, uint64_t m) {
+            uint64_t r = 0;
+            for (size_t i = digits.size(); i-- > 0;)
+                r = m < BASE ? (r * BASE + digits[i]) % m
+                             : (uint64_t)(((unsigned __int128)r * BASE + digits[i]) % m);
+            return r;
+        }
+
+        // 比较 |digits| 与 m；m < 2^64 < BASE^3
+        int compare_limbs(const LimbVector& digits, uint64_t m) {
+            if (digits.size() > 3) return 1;
+            unsigned __int128 value = 0;
+            for (size_t i = digits.size(); i-- > 0;)
+                value = value * BASE + digits[i];
+            return value < m ? -1 : (value > m ? 1 : 0);
+        }
+
+        // num += (negative ? -m : m)
+        void add_magnitude(BigInteger& num, uint64_t m, bool negative) {
+            if (m == 0) return;
+            if (is_zero(num)) num.is_negative = negative;
+
+            if (num.is_negative == negative) {
+                uint64_t carry = m;
+                for (size_t i = 0; carry; ++i) {
+                    if (i == num.digits.size()) num.digits.push_back(0);
+                    uint64_t cur = num.digits[i] + carry;
+                    num.digits[i] = (limb_t)(cur % BASE);
+                    carry = cur / BASE;
+                }
+                return;
+            }
+
+            if (compare_limbs(num.digits, m) >= 0) {
+                // |num| -= m，借位最多传到 m 的三个 limb 之外一位
+                uint64_t rest = m;
+                int64_t borrow = 0;
+                for (size_t i = 0; rest || borrow; ++i) {
+                    int64_t cur = (int64_t)num.digits[i] - (int64_t)(rest % BASE) - borrow;
+                    rest /= BASE;
+                    borrow = cur < 0;
+                    num.digits[i] = (limb_t)(cur < 0 ? cur + BASE : cur);
+                }
+                remove_leading_zeros(num);
+                if (is_zero(num)) num.is_negative = false;
+            } else {
+                // |num| < m，结果为 m - |num|，符号取 m 的
+                uint64_t value = 0;
+                for (size_t i = num.digits.size(); i-- > 0;)
+                    value = value * BASE + num.digits[i];
+                value = m - value;
+                num.digits.clear();
+                do {
+                    num.digits.push_back((limb_t)(value % BASE));
+                    value /= BASE;
+                } while (value);
+                num.is_negative = negative;
+            }
+        }
+    }
+
+    void add_small(BigInteger& num, int64_t k) {
+        add_magnitude(num, magnitude(k), k < 0);
+    }
+
+    void sub_small(BigInteger& num, int64_t k) {
+        add_magnitude(num, magnitude(k), k > 0);
+    }
+
+    void mul_small(BigInteger& num, int64_t k) {
+        mul_add_small(num, k, 0);
+    }
+
+    // num = num * k + c：c 与乘积同号时作为初始进位一并完成
+    void mul_add_small(BigInteger& num, int64_t k, int64_t c) {
+        const bool negative = num.is_negative != (k < 0);
+        const bool fused = c == 0 || (c < 0) == negative;
+        mul_add_limbs(num.digits, num.digits, magnitude(k), fused ? magnitude(c) : 0);
+        num.is_negative = negative;
+        remove_leading_zeros(num);
+        if (is_zero(num)) num.is_negative = false;
+        if (!fused) add_small(num, c);
+    }
+
+    // 商向零截断，余数与被除数同号
+    int64_t divmod_small(BigInteger& num, int64_t d) {
+        BIGINTEGER_STAT(SmallDiv, num.digits.size());
+        if (d == 0) {
+            throw std::invalid_argument("Division by zero");
+        }
+
+        const uint64_t m = magnitude(d);
+        uint64_t r = 0;
+        if (m < BASE) {
+            for (size_t i = num.digits.size(); i-- > 0;) {
+                uint64_t cur = r * BASE + num.digits[i];
+                num.digits[i] = (limb_t)(cur / m);
+                r = cur % m;
+            }
+        } else {
+            for (size_t i = num.digits.size(); i-- > 0;) {
+                unsigned __int128 cur = (unsigned __int128)r * BASE + num.digits[i];
+                num.digits[i] = (limb_t)(cur / m);
+                r = (uint64_t)(cur % m);
+            }
+        }
+
+        const bool dividend_negative = num.is_negative;
+        num.is_negative = dividend_negative != (d < 0);
+        remove_leading_zeros(num);
+        if (is_zero(num)) num.is_negative = false;
+        return dividend_negative ? -(int64_t)r : (int64_t)r;
+    }
+
+    int compare_small(const BigInteger& a, int64_t k) {
+        if (a.is_negative != (k < 0))
+            return a.is_negative ? -1 : 1;
+        int cmp = compare_limbs(a.digits, magnitude(k));
+        return a.is_negative ? -cmp : cmp;
+    }
+
+    BigInteger operator+(const BigInteger& a, int64_t k) {
+        BigInteger result = a;
+        add_small(result, k);
+        return result;
+    }
+
+    BigInteger operator-(const BigInteger& a, int64_t k) {
+        BigInteger result = a;
+        sub_small(result, k);
+        return result;
+    }
+
+    BigInteger operator*(const BigInteger& a, int64_t k) {
+        BigInteger result;
+        mul_add_limbs(result.digits, a.digits, magnitude(k), 0);
+        result.is_negative = a.is_negative != (k < 0);
+        remove_leading_zeros(result);
+        if (is_zero(result)) result.is_negative = false;
+        return result;
+    }
+
+    BigInteger operator*(int64_t k, const BigInteger& a) {
+        return a * k;
+    }
+
+    BigInteger operator/(const BigInteger& a, int64_t d) {
+        BigInteger result = a;
+        divmod_small(result, d);
+        return result;
+    }
+
+    int64_t operator%(const BigInteger& a, int64_t d) {
+        if (d == 0) {
+            throw std::invalid_argument("Division by zero");
+        }
+        int64_t r = (int64_t)mod_limbs(a.digits, magnitude(d));
+        return a.is_negative ? -r : r;
+    }
+
+    BigInteger operator+(BigInteger&& a, int64_t k) {
+        add_small(a, k);
+        return std::move(a);
+    }
+
+    BigInteger operator-(BigInteger&& a, int64_t k) {
+        sub_small(a, k);
+        return std::move(a);
+    }
+
+    BigInteger operator*(BigInteger&& a, int64_t k) {
+        mul_small(a, k);
+        return std::move(a);
+    }
+
+    BigInteger operator/(BigInteger&& a, int64_t d) {
+        divmod_small(a, d);
+        return std::move(a);
+    }
+
+    BigInteger& operator+=(BigInteger& a, int64_t k) {
+        add_small(a, k);
+        return a;
+    }
+
+    BigInteger& operator-=(BigInteger& a, int64_t k) {
+        sub_small(a, k);
+        return a;
+    }
+
+    BigInteger& operator*=(BigInteger& a, int64_t k) {
+        mul_small(a, k);
+        return a;
+    }
+
+    BigInteger& operator/=(BigInteger& a, int64_t d) {
+        divmod_small(a, d);
+        return a;
+    }
+
+    // 余数写回 a 原有的缓冲区
+    BigInteger& operator%=(BigInteger& a, int64_t d) {
+        int64_t r = a % d;
+        a.is_negative = r < 0;
+        uint64_t m = magnitude(r);
+        a.digits.clear();
+        do {
+            a.digits.push_back((limb_t)(m % BASE));
+            m /= BASE;
+        } while (m);
+        return a;
+    }
+
+    bool operator<(const BigInteger& a, int64_t k) { return compare_small(a, k) < 0; }
+    bool operator>(const BigInteger& a, int64_t k) { return compare_small(a, k) > 0; }
+    bool operator<=(const BigInteger& a, int64_t k) { return compare_small(a, k) <= 0; }
+    bool operator>=(const BigInteger& a, int64_t k) { return compare_small(a, k) >= 0; }
+    bool operator==(const BigInteger& a, int64_t k) { return compare_small(a, k) == 0; }
+}
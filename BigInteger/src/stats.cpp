@@ -0,0 +1,133 @@
+#include <BigInteger/biginteger.h>
+
+#include <atomic>
+#include <chrono>
+#include <iterator>
+
+namespace Biginteger{
+
+    namespace {
+
+        const size_t COUNTERS = (size_t)StatCounter::Count;
+
+        const char* const STAT_NAMES[] = {
+            "add", "sub", "small_mul", "small_div",
+            "schoolbook", "karatsuba", "toom3", "toom4", "fft", "ntt",
+            "knuth", "burnikel_ziegler", "newton", "reciprocal",
+            "powmod", "gcd", "half_gcd", "sqrt", "root", "product",
+            "binary_splitting",
+            "to_string", "from_string", "divide_decimal", "evaluate",
+        };
+        static_assert(std::size(STAT_NAMES) == COUNTERS, "STAT_NAMES must list every StatCounter");
+
+        // 各线程直接累加到共享的计数器上，relaxed 即可：读取时只要求最终的总和
+        struct Slot {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> nanoseconds{0};
+            std::atomic<uint64_t> bytes{0};
+            std::array<std::atomic<uint64_t>, STAT_BUCKETS> sizes{};
+        };
+
+        Slot slots[COUNTERS];
+
+#ifdef BIGINTEGER_STATS
+        thread_local StatScope* current = nullptr;
+
+        uint64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        size_t bucket(size_t limbs) {
+            size_t k = 0;
+            while (limbs > 1 && k + 1 < STAT_BUCKETS) {
+                limbs >>= 1;
+                ++k;
+            }
+            return k;
+        }
+#endif
+    }
+
+#ifdef BIGINTEGER_STATS
+    void note_allocation(size_t bytes) {
+        if (current) current->bytes += bytes;
+    }
+
+    StatScope::StatScope(StatCounter counter, size_t limbs) : counter(counter), parent(current) {
+        Slot& slot = slots[(size_t)counter];
+        slot.calls.fetch_add(1, std::memory_order_relaxed);
+        slot.sizes[bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+        current = this;
+        start = now();
+    }
+
+    StatScope::~StatScope() {
+        const uint64_t elapsed = now() - start;
+        Slot& slot = slots[(size_t)counter];
+        slot.nanoseconds.fetch_add(elapsed - std::min(nested, elapsed), std::memory_order_relaxed);
+        slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (parent) parent->nested += elapsed;
+        current = parent;
+    }
+#endif
+
+    bool stats_enabled() {
+#ifdef BIGINTEGER_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const char* stat_name(StatCounter counter) {
+        return (size_t)counter < COUNTERS ? STAT_NAMES[(size_t)counter] : "unknown";
+    }
+
+    std::vector<OperationStats> stats() {
+        std::vector<OperationStats> result(COUNTERS);
+        for (size_t i = 0; i < COUNTERS; ++i) {
+            result[i].calls = slots[i].calls.load(std::memory_order_relaxed);
+            result[i].nanoseconds = slots[i].nanoseconds.load(std::memory_order_relaxed);
+            result[i].bytes = slots[i].bytes.load(std::memory_order_relaxed);
+            for (size_t k = 0; k < STAT_BUCKETS; ++k)
+                result[i].sizes[k] = slots[i].sizes[k].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // 正在进行中的记录点析构时仍会把剩余部分计入
+    void reset_stats() {
+        for (auto& slot : slots) {
+            slot.calls.store(0, std::memory_order_relaxed);
+            slot.nanoseconds.store(0, std::memory_order_relaxed);
+            slot.bytes.store(0, std::memory_order_relaxed);
+            for (auto& count : slot.sizes) count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // {"enabled": true, "operations": {"karatsuba": {"calls": 3, ..., "sizes": {"64": 3}}, ...}}
+    // 只列出被调用过的运算；sizes 的键是该格的最小 limb 数（第 0 格也包括 0）
+    std::string stats_json() {
+        const std::vector<OperationStats> all = stats();
+        std::ostringstream out;
+        out << "{\"enabled\": " << (stats_enabled() ? "true" : "false") << ", \"operations\": {";
+        bool first = true;
+        for (size_t i = 0; i < COUNTERS; ++i) {
+            const OperationStats& s = all[i];
+            if (s.calls == 0) continue;
+            out << (first ? "" : ", ") << "\"" << STAT_NAMES[i] << "\": {\"calls\": " << s.calls
+                << ", \"nanoseconds\": " << s.nanoseconds << ", \"bytes\": " << s.bytes << ", \"sizes\": {";
+            bool first_bucket = true;
+            for (size_t k = 0; k < STAT_BUCKETS; ++k) {
+                if (s.sizes[k] == 0) continue;
+                out << (first_bucket ? "" : ", ") << "\"" << ((uint64_t)1 << k) << "\": " << s.sizes[k];
+                first_bucket = false;
+            }
+            out << "}}";
+            first = false;
+        }
+        out << "}}";
+        return out.str();
+    }
+}
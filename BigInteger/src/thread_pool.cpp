@@ -0,0 +1,221 @@
+#include <BigInteger/biginteger.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 一次 fork-join 的共享状态：未完成的任务数与第一个异常。parent 是发起这次调用的任务所属的组，
+        // 等待方只执行本组及其派生组的任务；都被别的线程取走后在 done 上阻塞
+        struct TaskGroup {
+            std::atomic<size_t> pending{0};
+            TaskGroup* parent = nullptr;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        };
+
+        struct Task {
+            const std::function<void()>* fn;
+            TaskGroup* group;
+        };
+
+        // 每个线程一个双端队列：自己从尾部取（后进先出，缓存更热），空闲线程从别人的头部窃取
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        class ThreadPool;
+        thread_local ThreadPool* current_pool = nullptr;
+        thread_local size_t current_index = 0;
+        thread_local TaskGroup* current_group = nullptr;
+
+        // 等待方找不到可执行的任务时先让出若干次 CPU，子任务很短时不必进入阻塞
+        const size_t JOIN_SPINS = 64;
+
+        bool descends(const TaskGroup* group, const TaskGroup* ancestor) {
+            for (; group; group = group->parent)
+                if (group == ancestor) return true;
+            return false;
+        }
+
+        class ThreadPool {
+        public:
+            // threads 为总并行度；队列 0 属于外部调用线程，工作线程使用 1..threads-1
+            explicit ThreadPool(size_t threads) : queues(threads) {
+                for (auto& queue : queues) queue = std::make_unique<WorkQueue>();
+                for (size_t i = 1; i < threads; ++i)
+                    workers.emplace_back([this, i] { worker_loop(i); });
+            }
+
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers) worker.join();
+            }
+
+            size_t size() const { return queues.size(); }
+
+            // 当前线程执行第一个任务，其余放进自己的队列。等待期间只执行本组及其派生组的任务，
+            // 栈上不会压入无关的工作；嵌套调用的任务总能由发起方自己执行，不会死锁
+            void run(const std::vector<std::function<void()>>& fns) {
+                TaskGroup group;
+                group.pending = fns.size();
+                group.parent = current_group;
+                const size_t self = current_pool == this ? current_index : 0;
+                {
+                    std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                    for (size_t i = fns.size(); i-- > 1;)
+                        queues[self]->tasks.push_back({&fns[i], &group});
+                }
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    queued += fns.size() - 1;
+                }
+                wake.notify_all();
+
+                execute({&fns[0], &group});
+                for (size_t spins = 0; group.pending.load(std::memory_order_acquire) > 0;) {
+                    if (run_one(self, &group)) {
+                        spins = 0;
+                    } else if (++spins < JOIN_SPINS) {
+                        std::this_thread::yield();
+                    } else {
+                        std::unique_lock<std::mutex> lock(group.mutex);
+                        group.done.wait(lock, [&] { return group.pending.load(std::memory_order_acquire) == 0; });
+                    }
+                }
+                // 自旋时可能在最后一个任务通知之前就看到计数归零：拿一次锁，等它离开临界区再销毁 group
+                std::lock_guard<std::mutex> lock(group.mutex);
+                if (group.error) std::rethrow_exception(group.error);
+            }
+
+        private:
+            std::vector<std::unique_ptr<WorkQueue>> queues;
+            std::vector<std::thread> workers;
+            std::mutex sleep_mutex;
+            std::condition_variable wake;
+            std::atomic<size_t> queued{0};
+            bool stopping = false;
+
+            static void execute(const Task& task) {
+                TaskGroup* const outer = current_group;
+                current_group = task.group;
+                try {
+                    (*task.fn)();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(task.group->mutex);
+                    if (!task.group->error) task.group->error = std::current_exception();
+                }
+                current_group = outer;
+                // 计数归零后等待方可能立即销毁 group：在锁内减计数并通知，等待方拿到锁之后才会返回
+                std::lock_guard<std::mutex> lock(task.group->mutex);
+                if (task.group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) task.group->done.notify_all();
+            }
+
+            // 自己的队列从尾部取，别人的从头部取；joining 非空时只取属于它或其派生组的任务
+            bool take(size_t index, bool own, const TaskGroup* joining, Task& task) {
+                WorkQueue& queue = *queues[index];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                const size_t n = queue.tasks.size();
+                for (size_t k = 0; k < n; ++k) {
+                    const size_t i = own ? n - 1 - k : k;
+                    if (joining && !descends(queue.tasks[i].group, joining)) continue;
+                    task = queue.tasks[i];
+                    queue.tasks.erase(queue.tasks.begin() + i);
+                    return true;
+                }
+                return false;
+            }
+
+            bool run_one(size_t self, const TaskGroup* joining = nullptr) {
+                Task task;
+                bool found = take(self, true, joining, task);
+                for (size_t k = 1; !found && k < queues.size(); ++k)
+                    found = take((self + k) % queues.size(), false, joining, task);
+                if (!found) return false;
+                queued.fetch_sub(1);
+                execute(task);
+                return true;
+            }
+
+            void worker_loop(size_t index) {
+                current_pool = this;
+                current_index = index;
+                for (;;) {
+                    if (run_one(index)) continue;
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+                    if (stopping) return;
+                }
+            }
+        };
+
+        size_t default_thread_count() {
+            if (const char* env = std::getenv("BIGINTEGER_THREADS")) {
+                char* end = nullptr;
+                unsigned long long n = std::strtoull(env, &end, 10);
+                if (end != env && *end == '\0' && n > 0) return (size_t)n;
+                std::cerr << "BIGINTEGER_THREADS: invalid value '" << env << "', using hardware concurrency\n";
+            }
+            return std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        std::mutex pool_mutex;
+        std::unique_ptr<ThreadPool> pool;
+
+        ThreadPool& thread_pool() {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (!pool) pool = std::make_unique<ThreadPool>(default_thread_count());
+            return *pool;
+        }
+    }
+
+    void set_thread_count(size_t n) {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool.reset();
+        pool = std::make_unique<ThreadPool>(std::max<size_t>(1, n));
+    }
+
+    size_t thread_count() {
+        return thread_pool().size();
+    }
+
+    void parallel_invoke(const std::vector<std::function<void()>>& tasks, size_t limbs) {
+        // 先判断规模，小问题不必碰线程池的锁
+        if (tasks.size() <= 1 || limbs < thresholds().parallel || thread_pool().size() == 1) {
+            for (const auto& task : tasks) task();
+            return;
+        }
+        thread_pool().run(tasks);
+    }
+
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body) {
+        if (begin >= end) return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (end - begin) / grain < 2 ? 1 : std::min(thread_pool().size(), (end - begin) / grain);
+        if (chunks <= 1) {
+            body(begin, end);
+            return;
+        }
+
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(chunks);
+        const size_t step = (end - begin + chunks - 1) / chunks;
+        for (size_t lo = begin; lo < end; lo += step) {
+            const size_t hi = std::min(end, lo + step);
+            tasks.emplace_back([&body, lo, hi] { body(lo, hi); });
+        }
+        thread_pool().run(tasks);
+    }
+}
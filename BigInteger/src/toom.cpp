@@ -0,0 +1,344 @@
+#include <BigInteger/biginteger.h>
+
+namespace Biginteger{
+
+    namespace {
+
+        // 第 i 段的长度（每段 m 个 limb），最高的几段可能不足 m 或为空
+        size_t part_length(size_t n, size_t i, size_t m) {
+            return n > i * m ? std::min(m, n - i * m) : 0;
+        }
+
+        // x[0..n) *= k，调用方保证结果放得下
+        void scale_limbs(limb_t* x, size_t n, limb_t k) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t cur = (uint64_t)x[i] * k + carry;
+                x[i] = (limb_t)(cur % BASE);
+                carry = cur / BASE;
+            }
+        }
+
+        // out[0..n) = x * k
+        void scaled_copy(limb_t* out, size_t n, const limb_t* x, size_t nx, limb_t k) {
+            std::fill(std::copy(x, x + nx, out), out + n, 0);
+            scale_limbs(out, n, k);
+        }
+
+        // x[0..n) /= d，插值中的除法都是整除
+        void divide_exact(limb_t* x, size_t n, limb_t d) {
+            uint64_t rem = 0;
+            for (size_t i = n; i-- > 0;) {
+                uint64_t cur = rem * BASE + x[i];
+                x[i] = (limb_t)(cur / d);
+                rem = cur % d;
+            }
+        }
+
+        // out[0..n) = |x - y|，两者都是 n 个 limb，返回 x < y；out 可以与 x 或 y 相同
+        bool abs_diff(limb_t* out, const limb_t* x, const limb_t* y, size_t n) {
+            size_t i = n;
+            while (i > 0 && x[i - 1] == y[i - 1]) --i;
+            if (i > 0 && x[i - 1] < y[i - 1]) {
+                sub_limbs(out, y, n, x, n);
+                return true;
+            }
+            sub_limbs(out, x, n, y, n);
+            return false;
+        }
+
+        // out[0..n) = p[0] + k p[1] + k^2 p[2] + ...，按 Horner 从最高的段开始
+        void horner(limb_t* out, size_t n, const limb_t* const* p, const size_t* len, size_t count, limb_t k) {
+            std::fill(std::copy(p[count - 1], p[count - 1] + len[count - 1], out), out + n, 0);
+            for (size_t i = count - 1; i-- > 0;) {
+                if (k != 1) scale_limbs(out, n, k);
+                add_limbs(out, out, n, p[i], len[i]);
+            }
+        }
+
+        // 子乘积，任一方为空时结果为零，out 已经清零，什么也不写
+        void product(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch) {
+            if (na > 0 && nb > 0) mul_limbs(out, a, na, b, nb, scratch);
+        }
+
+        // out += r * BASE^shift，out 共 n 个 limb；各系数非负，部分和不超过最终结果，进位不会越界
+        void accumulate(limb_t* out, size_t n, const limb_t* r, size_t len, size_t shift) {
+            len = trimmed_length(r, len);
+            if (len > 0) add_limbs(out + shift, out + shift, n - shift, r, len);
+        }
+
+        // 同一组子乘积的临时空间：并行时各占一段，串行时共用
+        size_t products_scratch(const size_t (*shape)[2], size_t count, size_t m) {
+            size_t total = 0, widest = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const size_t s = mul_scratch(shape[i][0], shape[i][1]);
+                total += s;
+                widest = std::max(widest, s);
+            }
+            return m >= thresholds().parallel ? total : widest;
+        }
+    }
+
+    // Toom-3 在 limb 区间上原地完成：a、b 各切成三段，在 0, 1, -1, 2, ∞ 处求值。
+    // v0、vinf 直接写进 out 的低、高两段，求值结果、其余三个乘积和子问题的临时空间都在 scratch 里
+    size_t toom3_scratch(size_t na, size_t nb) {
+        const size_t m = (na + 2) / 3, L = 2 * m + 2;
+        const size_t shape[5][2] = {{m, part_length(nb, 0, m)}, {m + 1, m + 1}, {m + 1, m + 1}, {m + 1, m + 1},
+                                    {part_length(na, 2, m), part_length(nb, 2, m)}};
+        return 6 * (m + 1) + 3 * L + products_scratch(shape, 5, m);
+    }
+
+    void toom3_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch) {
+        BIGINTEGER_STAT(Toom3, nb);
+        const size_t m = (na + 2) / 3, L = 2 * m + 2, n = na + nb;
+        const limb_t* ap[3] = {a, a + m, a + 2 * m};
+        const limb_t* bp[3] = {b, b + m, b + 2 * m};
+        size_t la[3], lb[3];
+        for (size_t i = 0; i < 3; ++i) {
+            la[i] = part_length(na, i, m);
+            lb[i] = part_length(nb, i, m);
+        }
+
+        limb_t* ea = scratch;            // a(1), |a(-1)|, a(2)
+        limb_t* eb = ea + 3 * (m + 1);   // b(1), |b(-1)|, b(2)
+        limb_t* V1 = eb + 3 * (m + 1);
+        limb_t* VM1 = V1 + L;
+        limb_t* V2 = VM1 + L;
+        limb_t* rest = V2 + L;
+
+        // 求值：p(-1) 先借 p(2) 的位置放奇数段，再与偶数段相减
+        bool negative = false;
+        auto evaluate = [&](const limb_t* const* p, const size_t* len, limb_t* e) {
+            limb_t* e1 = e;
+            limb_t* em1 = e + (m + 1);
+            limb_t* e2 = em1 + (m + 1);
+            horner(e1, m + 1, p, len, 3, 1);
+            const limb_t* even[2] = {p[0], p[2]};
+            const size_t even_len[2] = {len[0], len[2]};
+            horner(em1, m + 1, even, even_len, 2, 1);
+            std::fill(std::copy(p[1], p[1] + len[1], e2), e2 + m + 1, 0);
+            negative ^= abs_diff(em1, em1, e2, m + 1);
+            horner(e2, m + 1, p, len, 3, 2);
+        };
+        evaluate(ap, la, ea);
+        evaluate(bp, lb, eb);
+
+        std::fill(out, out + n, 0);
+        limb_t* vinf = out + 4 * m;
+        const size_t lvinf = la[2] && lb[2] ? la[2] + lb[2] : 0;
+        const size_t shape[5][2] = {{la[0], lb[0]}, {m + 1, m + 1}, {m + 1, m + 1}, {m + 1, m + 1}, {la[2], lb[2]}};
+        if (m >= thresholds().parallel) {
+            limb_t* s[5];
+            s[0] = rest;
+            for (size_t i = 1; i < 5; ++i) s[i] = s[i - 1] + mul_scratch(shape[i - 1][0], shape[i - 1][1]);
+            parallel_invoke({
+                [=] { product(out, ap[0], la[0], bp[0], lb[0], s[0]); },
+                [=] { product(V1, ea, m + 1, eb, m + 1, s[1]); },
+                [=] { product(VM1, ea + (m + 1), m + 1, eb + (m + 1), m + 1, s[2]); },
+                [=] { product(V2, ea + 2 * (m + 1), m + 1, eb + 2 * (m + 1), m + 1, s[3]); },
+                [=] { product(vinf, ap[2], la[2], bp[2], lb[2], s[4]); },
+            }, m);
+        } else {
+            product(out, ap[0], la[0], bp[0], lb[0], rest);
+            product(V1, ea, m + 1, eb, m + 1, rest);
+            product(VM1, ea + (m + 1), m + 1, eb + (m + 1), m + 1, rest);
+            product(V2, ea + 2 * (m + 1), m + 1, eb + 2 * (m + 1), m + 1, rest);
+            product(vinf, ap[2], la[2], bp[2], lb[2], rest);
+        }
+        const limb_t* v0 = out;
+        const size_t lv0 = la[0] + lb[0];
+
+        // 插值（Bodrato）：各步的中间值都非负，只有 v(-1) 带符号
+        if (negative) add_limbs(V2, V2, L, VM1, L);
+        else sub_limbs(V2, V2, L, VM1, L);
+        divide_exact(V2, L, 3);                           // r1 + r2 + 3 r3 + 5 r4
+        if (negative) add_limbs(VM1, V1, L, VM1, L);
+        else sub_limbs(VM1, V1, L, VM1, L);
+        divide_exact(VM1, L, 2);                          // r1 + r3
+        sub_limbs(V1, V1, L, v0, lv0);                    // r1 + r2 + r3 + r4
+        sub_limbs(V2, V2, L, V1, L);
+        divide_exact(V2, L, 2);                           // r3 + 2 r4
+        sub_limbs(V1, V1, L, VM1, L);
+        sub_limbs(V1, V1, L, vinf, lvinf);                // r2
+        sub_limbs(V2, V2, L, vinf, lvinf);
+        sub_limbs(V2, V2, L, vinf, lvinf);                // r3
+        sub_limbs(VM1, VM1, L, V2, L);                    // r1
+
+        accumulate(out, n, VM1, L, m);
+        accumulate(out, n, V1, L, 2 * m);
+        accumulate(out, n, V2, L, 3 * m);
+    }
+
+    // Toom-4 在 limb 区间上原地完成：四段，在 0, ±1, ±2, 1/2, ∞ 处求值，按奇偶部分拆开插值
+    size_t toom4_scratch(size_t na, size_t nb) {
+        const size_t m = (na + 3) / 4, L = 2 * m + 2;
+        const size_t shape[7][2] = {{m, part_length(nb, 0, m)}, {m + 1, m + 1}, {m + 1, m + 1}, {m + 1, m + 1},
+                                    {m + 1, m + 1}, {m + 1, m + 1}, {part_length(na, 3, m), part_length(nb, 3, m)}};
+        return 10 * (m + 1) + 6 * L + products_scratch(shape, 7, m);
+    }
+
+    void toom4_limbs(limb_t* out, const limb_t* a, size_t na, const limb_t* b, size_t nb, limb_t* scratch) {
+        BIGINTEGER_STAT(Toom4, nb);
+        const size_t m = (na + 3) / 4, L = 2 * m + 2, n = na + nb;
+        const limb_t* ap[4];
+        const limb_t* bp[4];
+        size_t la[4], lb[4];
+        for (size_t i = 0; i < 4; ++i) {
+            ap[i] = a + i * m;
+            bp[i] = b + i * m;
+            la[i] = part_length(na, i, m);
+            lb[i] = part_length(nb, i, m);
+        }
+
+        // 求值顺序为 p(1), |p(-1)|, p(2), |p(-2)|, 8 p(1/2)；奇数段先放在 8 p(1/2) 的位置
+        limb_t* ea = scratch;
+        limb_t* eb = ea + 5 * (m + 1);
+        limb_t* V1 = eb + 5 * (m + 1);
+        limb_t* VM1 = V1 + L;
+        limb_t* V2 = VM1 + L;
+        limb_t* VM2 = V2 + L;
+        limb_t* VH = VM2 + L;
+        limb_t* T = VH + L;
+        limb_t* rest = T + L;
+
+        bool negative1 = false, negative2 = false;
+        auto evaluate = [&](const limb_t* const* p, const size_t* len, limb_t* e0) {
+            limb_t* e[5];
+            for (size_t i = 0; i < 5; ++i) e[i] = e0 + i * (m + 1);
+            const limb_t* even[2] = {p[0], p[2]};
+            const limb_t* odd[2] = {p[1], p[3]};
+            const size_t even_len[2] = {len[0], len[2]}, odd_len[2] = {len[1], len[3]};
+
+            horner(e[0], m + 1, even, even_len, 2, 1);
+            horner(e[4], m + 1, odd, odd_len, 2, 1);
+            negative1 ^= abs_diff(e[1], e[0], e[4], m + 1);
+            add_limbs(e[0], e[0], m + 1, e[4], m + 1);
+
+            horner(e[2], m + 1, even, even_len, 2, 4);
+            horner(e[4], m + 1, odd, odd_len, 2, 4);
+            scale_limbs(e[4], m + 1, 2);
+            negative2 ^= abs_diff(e[3], e[2], e[4], m + 1);
+            add_limbs(e[2], e[2], m + 1, e[4], m + 1);
+
+            const limb_t* reversed[4] = {p[3], p[2], p[1], p[0]};
+            const size_t reversed_len[4] = {len[3], len[2], len[1], len[0]};
+            horner(e[4], m + 1, reversed, reversed_len, 4, 2);
+        };
+        evaluate(ap, la, ea);
+        evaluate(bp, lb, eb);
+
+        std::fill(out, out + n, 0);
+        limb_t* vinf = out + 6 * m;
+        const size_t lvinf = la[3] && lb[3] ? la[3] + lb[3] : 0;
+        limb_t* V[5] = {V1, VM1, V2, VM2, VH};
+        const size_t shape[7][2] = {{la[0], lb[0]}, {m + 1, m + 1}, {m + 1, m + 1}, {m + 1, m + 1},
+                                    {m + 1, m + 1}, {m + 1, m + 1}, {la[3], lb[3]}};
+        if (m >= thresholds().parallel) {
+            limb_t* s[7];
+            s[0] = rest;
+            for (size_t i = 1; i < 7; ++i) s[i] = s[i - 1] + mul_scratch(shape[i - 1][0], shape[i - 1][1]);
+            std::vector<std::function<void()>> tasks;
+            tasks.push_back([=] { product(out, ap[0], la[0], bp[0], lb[0], s[0]); });
+            for (size_t i = 0; i < 5; ++i)
+                tasks.push_back([=] { product(V[i], ea + i * (m + 1), m + 1, eb + i * (m + 1), m + 1, s[i + 1]); });
+            tasks.push_back([=] { product(vinf, ap[3], la[3], bp[3], lb[3], s[6]); });
+            parallel_invoke(tasks, m);
+        } else {
+            product(out, ap[0], la[0], bp[0], lb[0], rest);
+            for (size_t i = 0; i < 5; ++i)
+                product(V[i], ea + i * (m + 1), m + 1, eb + i * (m + 1), m + 1, rest);
+            product(vinf, ap[3], la[3], bp[3], lb[3], rest);
+        }
+        const limb_t* v0 = out;
+        const size_t lv0 = la[0] + lb[0];
+
+        // 偶次项：r2 + r4 与 r2 + 4 r4
+        if (negative1) {
+            add_limbs(T, V1, L, VM1, L);
+            sub_limbs(V1, V1, L, VM1, L);
+        } else {
+            sub_limbs(T, V1, L, VM1, L);
+            add_limbs(V1, V1, L, VM1, L);
+        }
+        divide_exact(T, L, 2);                            // O1 = r1 + r3 + r5
+        divide_exact(V1, L, 2);
+        sub_limbs(V1, V1, L, v0, lv0);
+        sub_limbs(V1, V1, L, vinf, lvinf);                // E1 = r2 + r4
+        if (negative2) {
+            add_limbs(VM1, V2, L, VM2, L);
+            sub_limbs(V2, V2, L, VM2, L);
+        } else {
+            sub_limbs(VM1, V2, L, VM2, L);
+            add_limbs(V2, V2, L, VM2, L);
+        }
+        divide_exact(VM1, L, 4);                          // O2 = r1 + 4 r3 + 16 r5
+        divide_exact(V2, L, 2);
+        sub_limbs(V2, V2, L, v0, lv0);
+        scaled_copy(VM2, L, vinf, lvinf, 64);
+        sub_limbs(V2, V2, L, VM2, L);
+        divide_exact(V2, L, 4);                           // E2 = r2 + 4 r4
+        sub_limbs(V2, V2, L, V1, L);
+        divide_exact(V2, L, 3);                           // r4
+        sub_limbs(V1, V1, L, V2, L);                      // r2
+
+        // 奇次项：O1、O2 与 h = 16 r1 + 4 r3 + r5
+        scaled_copy(VM2, L, v0, lv0, 64);
+        sub_limbs(VH, VH, L, VM2, L);
+        scaled_copy(VM2, L, V1, L, 16);
+        sub_limbs(VH, VH, L, VM2, L);
+        scaled_copy(VM2, L, V2, L, 4);
+        sub_limbs(VH, VH, L, VM2, L);
+        sub_limbs(VH, VH, L, vinf, lvinf);
+        divide_exact(VH, L, 2);                           // h
+        sub_limbs(VM1, VM1, L, T, L);
+        divide_exact(VM1, L, 3);                          // t = r3 + 5 r5
+        scaled_copy(VM2, L, T, L, 16);
+        sub_limbs(VM2, VM2, L, VH, L);                    // 16 O1 - h = 12 r3 + 15 r5
+        scaled_copy(VH, L, VM1, L, 12);
+        sub_limbs(VH, VH, L, VM2, L);
+        divide_exact(VH, L, 45);                          // r5
+        scaled_copy(VM2, L, VH, L, 5);
+        sub_limbs(VM1, VM1, L, VM2, L);                   // r3
+        sub_limbs(T, T, L, VM1, L);
+        sub_limbs(T, T, L, VH, L);                        // r1
+
+        accumulate(out, n, T, L, m);
+        accumulate(out, n, V1, L, 2 * m);
+        accumulate(out, n, VM1, L, 3 * m);
+        accumulate(out, n, V2, L, 4 * m);
+        accumulate(out, n, VH, L, 5 * m);
+    }
+
+    // 结果之外的临时空间一次从线程的 ScratchFrame 取出；长度悬殊时由 multiply_dispatch 切成平衡的段
+    BigInteger toom3(const BigInteger& a, const BigInteger& b) {
+        const BigInteger& x = a.digits.size() >= b.digits.size() ? a : b;
+        const BigInteger& y = a.digits.size() >= b.digits.size() ? b : a;
+        const size_t na = x.digits.size(), nb = y.digits.size();
+        if (2 * nb <= na)
+            return multiply_dispatch(x, y);
+
+        ScratchFrame frame;
+        limb_t* scratch = frame.limbs(toom3_scratch(na, nb));
+        BigInteger result;
+        result.digits.resize(na + nb);
+        toom3_limbs(result.digits.data(), x.digits.data(), na, y.digits.data(), nb, scratch);
+        remove_leading_zeros(result);
+        return result;
+    }
+
+    BigInteger toom4(const BigInteger& a, const BigInteger& b) {
+        const BigInteger& x = a.digits.size() >= b.digits.size() ? a : b;
+        const BigInteger& y = a.digits.size() >= b.digits.size() ? b : a;
+        const size_t na = x.digits.size(), nb = y.digits.size();
+        if (2 * nb <= na)
+            return multiply_dispatch(x, y);
+
+        ScratchFrame frame;
+        limb_t* scratch = frame.limbs(toom4_scratch(na, nb));
+        BigInteger result;
+        result.digits.resize(na + nb);
+        toom4_limbs(result.digits.data(), x.digits.data(), na, y.digits.data(), nb, scratch);
+        remove_leading_zeros(result);
+        return result;
+    }
+}
@@ -0,0 +1,97 @@
+#include <BigInteger/biginteger.h>
+
+#include <cstdlib>
+#include <fstream>
+
+namespace Biginteger{
+
+    namespace {
+
+        struct ThresholdKey {
+            const char* name;
+            size_t Thresholds::* field;
+        };
+
+        // 配置文件中的键名，读写共用
+        const ThresholdKey THRESHOLD_KEYS[] = {
+            {"karatsuba", &Thresholds::karatsuba},
+            {"toom3", &Thresholds::toom3},
+            {"toom4", &Thresholds::toom4},
+            {"fft", &Thresholds::fft},
+            {"ntt", &Thresholds::ntt},
+            {"ntt_max", &Thresholds::ntt_max},
+            {"bz", &Thresholds::bz},
+            {"newton", &Thresholds::newton},
+            {"hgcd", &Thresholds::hgcd},
+            {"parallel", &Thresholds::parallel},
+        };
+
+        const size_t MIN_THRESHOLD = 4;
+
+        std::string trim(const std::string& s) {
+            size_t begin = s.find_first_not_of(" \t\r");
+            if (begin == std::string::npos) return "";
+            size_t end = s.find_last_not_of(" \t\r");
+            return s.substr(begin, end - begin + 1);
+        }
+    }
+
+    Thresholds& thresholds() {
+        static Thresholds instance = [] {
+            Thresholds t;
+            if (const char* path = std::getenv("BIGINTEGER_TUNING")) {
+                try {
+                    t = read_thresholds(path);
+                } catch (const std::exception& e) {
+                    std::cerr << "BIGINTEGER_TUNING ignored: " << e.what() << '\n';
+                }
+            }
+            return t;
+        }();
+        return instance;
+    }
+
+    // 格式为每行 "名称 = 值"，# 开头为注释；未出现的键保留默认值
+    Thresholds read_thresholds(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::invalid_argument("Cannot open tuning file: " + path);
+
+        Thresholds t;
+        std::string line;
+        while (std::getline(in, line)) {
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty()) continue;
+
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) throw std::invalid_argument("Malformed tuning line: " + line);
+            std::string key = trim(line.substr(0, eq));
+            std::string value = trim(line.substr(eq + 1));
+
+            bool known = false;
+            for (const auto& k : THRESHOLD_KEYS) {
+                if (key == k.name) {
+                    size_t pos = 0;
+                    unsigned long long v = std::stoull(value, &pos);
+                    // 过小的阈值会让分治乘法的子问题不再缩小
+                    if (pos != value.size() || v < MIN_THRESHOLD) throw std::invalid_argument("Bad tuning value: " + line);
+                    t.*k.field = v;
+                    known = true;
+                }
+            }
+            if (!known) throw std::invalid_argument("Unknown tuning key: " + key);
+        }
+        return t;
+    }
+
+    void load_thresholds(const std::string& path) {
+        thresholds() = read_thresholds(path);
+    }
+
+    void save_thresholds(const Thresholds& t, const std::string& path) {
+        std::ofstream out(path);
+        if (!out) throw std::invalid_argument("Cannot write tuning file: " + path);
+        out << "# BigInteger thresholds in limbs, generated by tune\n";
+        for (const auto& k : THRESHOLD_KEYS)
+            out << k.name << " = " << t.*k.field << '\n';
+    }
+}
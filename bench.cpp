@@ -0,0 +1,271 @@
+#include <BigInteger/biginteger.h>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+
+// 各运算在 10 到 10^7 位十进制数上的耗时，结果以 JSON 输出
+// 用法：bench [--ops add,mul,...] [--min-digits N] [--max-digits N] [--repeats R] [--warmup W]
+//            [--budget 秒] [--seed S] [--out 文件]
+
+using namespace Biginteger;
+
+namespace {
+
+    struct Options {
+        std::vector<std::string> ops;
+        size_t min_digits = 10;
+        size_t max_digits = 10000000;
+        size_t repeats = 11;
+        size_t warmup = 2;
+        double budget = 2.0; // 每个 (运算, 规模) 的时间预算；单次调用超过它后不再测更大的规模
+        uint64_t seed = 20240601;
+        std::string out;
+    };
+
+    // 恰好 digits 位的正数，最高 limb 不为零
+    BigInteger random_number(std::mt19937_64& rng, size_t digits) {
+        const size_t limbs = (digits + BASE_DIGITS - 1) / BASE_DIGITS;
+        limb_t top = 1;
+        for (size_t i = 0; i < digits - (limbs - 1) * BASE_DIGITS; ++i) top *= 10;
+        BigInteger num;
+        num.digits.resize(limbs);
+        for (auto& limb : num.digits) limb = rng() % BASE;
+        num.digits.back() = top / 10 + rng() % (top - top / 10);
+        return num;
+    }
+
+    // 一个测试项：prepare 按规模生成操作数并返回被计时的调用；limit 为可用的最大位数
+    struct Case {
+        const char* name;
+        std::function<std::function<void()>(std::mt19937_64&, size_t)> prepare;
+        size_t limit = std::numeric_limits<size_t>::max();
+    };
+
+    size_t sink = 0; // 让结果保持可见，避免调用被优化掉
+
+    using Binary = BigInteger (*)(const BigInteger&, const BigInteger&);
+
+    Case binary(const char* name, Binary f, size_t limit = std::numeric_limits<size_t>::max()) {
+        return {name, [f](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+            auto a = random_number(rng, digits), b = random_number(rng, digits);
+            return [f, a, b] { sink += f(a, b).digits.size(); };
+        }, limit};
+    }
+
+    std::vector<Case> all_cases() {
+        // double FFT 的精度只覆盖两操作数总长不超过 NTT_THRESHOLD 的情形
+        const size_t fft_limit = NTT_THRESHOLD / 2 * BASE_DIGITS;
+        return {
+            binary("add", [](const BigInteger& a, const BigInteger& b) { return a + b; }),
+            binary("sub", [](const BigInteger& a, const BigInteger& b) { return a - b; }),
+            binary("mul", [](const BigInteger& a, const BigInteger& b) { return a * b; }),
+            binary("mul_schoolbook", multiply_abs),
+            binary("mul_karatsuba", karatsuba),
+            binary("mul_toom3", toom3),
+            binary("mul_toom4", toom4),
+            binary("mul_fft", FFT_multiply, fft_limit),
+            binary("mul_ntt", NTT_multiply),
+            {"square", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto a = random_number(rng, digits);
+                return [a] { sink += (a * a).digits.size(); };
+            }},
+            // 除法与取模的被除数为 2n 位，除数为 n 位
+            {"divide", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto a = random_number(rng, 2 * digits), b = random_number(rng, digits);
+                return [a, b] {
+                    BigInteger remainder;
+                    sink += divide(a, b, remainder).digits.size();
+                };
+            }},
+            {"mod", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto a = random_number(rng, 2 * digits), b = random_number(rng, digits);
+                return [a, b] { sink += (a % b).digits.size(); };
+            }},
+            binary("gcd", gcd),
+            {"isqrt", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto a = random_number(rng, digits);
+                return [a] { sink += isqrt(a).digits.size(); };
+            }},
+            // 约 n / 9 个单 limb 因子的乘积树，结果约为 n 位
+            {"product", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                std::vector<BigInteger> factors((digits + BASE_DIGITS - 1) / BASE_DIGITS);
+                for (auto& f : factors) f = random_number(rng, BASE_DIGITS);
+                return [factors] { sink += product(factors).digits.size(); };
+            }},
+            // π 的前 n 位：二分法求和、Newton 除法与开方、十进制转换的端到端耗时
+            {"pi", [](std::mt19937_64&, size_t digits) -> std::function<void()> {
+                return [digits] { sink += compute_constant(Constant::Pi, digits).digits.size(); };
+            }},
+            {"to_string", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto a = random_number(rng, digits);
+                return [a] { sink += to_string(a).size(); };
+            }},
+            {"from_string", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto s = to_string(random_number(rng, digits));
+                return [s] { sink += from_string(s).digits.size(); };
+            }},
+            // 编译好的表达式，变量都是 n 位数
+            {"evaluate", [](std::mt19937_64& rng, size_t digits) -> std::function<void()> {
+                auto compiled = std::make_shared<CompiledExpression>(compile("(a + b) * c - max(a, b) / d"));
+                std::vector<BigInteger> bindings;
+                for (size_t i = 0; i < compiled->variables.size(); ++i) bindings.push_back(random_number(rng, digits));
+                return [compiled, bindings] { sink += evaluate(*compiled, bindings).digits.size(); };
+            }},
+        };
+    }
+
+    struct Stats {
+        size_t samples = 0;
+        size_t inner = 0; // 每个样本内的调用次数
+        double min = 0, median = 0, p90 = 0, max = 0, mean = 0; // 单次调用的纳秒数
+    };
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 预热后按单次耗时确定每个样本的调用次数（样本至少约 1ms），再在预算内取样
+    Stats measure(const std::function<void()>& f, const Options& opt) {
+        const double min_sample = 1e-3;
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double once = seconds_since(start);
+        for (size_t i = 1; i < opt.warmup && once < opt.budget / 8; ++i) {
+            start = std::chrono::steady_clock::now();
+            f();
+            once = std::min(once, seconds_since(start));
+        }
+
+        Stats s;
+        s.inner = once >= min_sample ? 1 : (size_t)std::ceil(min_sample / std::max(once, 1e-9));
+        const double per_sample = std::max(once * s.inner, 1e-9);
+        s.samples = std::clamp((size_t)(opt.budget / per_sample), std::min<size_t>(3, opt.repeats), opt.repeats);
+
+        std::vector<double> ns;
+        for (size_t i = 0; i < s.samples; ++i) {
+            start = std::chrono::steady_clock::now();
+            for (size_t k = 0; k < s.inner; ++k) f();
+            ns.push_back(seconds_since(start) * 1e9 / s.inner);
+        }
+        std::sort(ns.begin(), ns.end());
+        auto percentile = [&](double q) { return ns[std::min(ns.size() - 1, (size_t)std::ceil(q * ns.size()) - 1)]; };
+        s.min = ns.front();
+        s.max = ns.back();
+        s.median = ns.size() % 2 ? ns[ns.size() / 2] : (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]) / 2;
+        s.p90 = percentile(0.9);
+        for (double x : ns) s.mean += x / ns.size();
+        return s;
+    }
+
+    // 10, 30, 100, 300, ... 中落在 [min, max] 内的规模
+    std::vector<size_t> sizes(const Options& opt) {
+        std::vector<size_t> result;
+        for (size_t decade = 10; decade <= opt.max_digits; decade *= 10) {
+            for (size_t n : {decade, 3 * decade})
+                if (n >= opt.min_digits && n <= opt.max_digits) result.push_back(n);
+        }
+        return result;
+    }
+
+    std::vector<std::string> split(const std::string& s, char sep) {
+        std::vector<std::string> parts;
+        std::stringstream in(s);
+        for (std::string part; std::getline(in, part, sep);)
+            if (!part.empty()) parts.push_back(part);
+        return parts;
+    }
+
+    Options parse_options(int argc, char** argv) {
+        Options opt;
+        for (int i = 1; i < argc; ++i) {
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::invalid_argument(std::string("Missing value for ") + argv[i]);
+                return argv[++i];
+            };
+            if (!std::strcmp(argv[i], "--ops")) opt.ops = split(value(), ',');
+            else if (!std::strcmp(argv[i], "--min-digits")) opt.min_digits = std::max<size_t>(1, std::stoull(value()));
+            else if (!std::strcmp(argv[i], "--max-digits")) opt.max_digits = std::stoull(value());
+            else if (!std::strcmp(argv[i], "--repeats")) opt.repeats = std::max<size_t>(1, std::stoull(value()));
+            else if (!std::strcmp(argv[i], "--warmup")) opt.warmup = std::max<size_t>(1, std::stoull(value()));
+            else if (!std::strcmp(argv[i], "--budget")) opt.budget = std::stod(value());
+            else if (!std::strcmp(argv[i], "--seed")) opt.seed = std::stoull(value());
+            else if (!std::strcmp(argv[i], "--out")) opt.out = value();
+            else throw std::invalid_argument(std::string("Unknown option: ") + argv[i]);
+        }
+        return opt;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    try {
+        opt = parse_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<Case> cases = all_cases();
+    if (!opt.ops.empty()) {
+        std::vector<Case> chosen;
+        for (const auto& name : opt.ops) {
+            auto it = std::find_if(cases.begin(), cases.end(), [&](const Case& c) { return name == c.name; });
+            if (it == cases.end()) {
+                std::cerr << "Unknown operation: " << name << "\n";
+                return 1;
+            }
+            chosen.push_back(*it);
+        }
+        cases = chosen;
+    }
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(1);
+    const Thresholds& t = thresholds();
+    json << "{\n  \"seed\": " << opt.seed
+         << ",\n  \"simd\": \"" << simd_level_name(simd_level()) << "\""
+         << ",\n  \"threads\": " << thread_count()
+         << ",\n  \"thresholds\": {\"karatsuba\": " << t.karatsuba << ", \"toom3\": " << t.toom3
+         << ", \"toom4\": " << t.toom4 << ", \"fft\": " << t.fft << ", \"ntt\": " << t.ntt
+         << ", \"ntt_max\": " << t.ntt_max
+         << ", \"bz\": " << t.bz << ", \"newton\": " << t.newton << ", \"hgcd\": " << t.hgcd
+         << ", \"parallel\": " << t.parallel << "}"
+         << ",\n  \"results\": [";
+
+    bool first = true;
+    for (const auto& c : cases) {
+        for (size_t digits : sizes(opt)) {
+            if (digits > c.limit) break;
+            // 操作数只由种子和规模决定，与选了哪些运算无关
+            std::mt19937_64 rng(opt.seed + digits);
+            Stats s = measure(c.prepare(rng, digits), opt);
+            std::cerr << c.name << " digits=" << digits << " median " << s.median / 1e6 << "ms\n";
+
+            json << (first ? "\n" : ",\n") << "    {\"op\": \"" << c.name << "\", \"digits\": " << digits
+                 << ", \"samples\": " << s.samples << ", \"inner\": " << s.inner
+                 << ", \"min_ns\": " << s.min << ", \"median_ns\": " << s.median << ", \"p90_ns\": " << s.p90
+                 << ", \"max_ns\": " << s.max << ", \"mean_ns\": " << s.mean << "}";
+            first = false;
+            if (s.min > opt.budget * 1e9) break;
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (opt.out.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file(opt.out);
+        if (!file) {
+            std::cerr << "cannot open " << opt.out << "\n";
+            return 1;
+        }
+        file << json.str();
+    }
+    return sink == 0; // sink 不可能为零
+}
@@ -1,32 +1,8 @@
 #include <BigInteger/biginteger.h>
-#include <chrono>
 #include <cassert>
-
-void benchmark() {
-
-    std::string big_num1(1000, '0');
-    std::string big_num2(1000, '0');
-    for (auto& c : big_num1) c = '0' + rand()%10;
-    for (auto& c : big_num2) c = '0' + rand()%10;
-    
-    Biginteger::BigInteger a = Biginteger::from_string(big_num1);
-    Biginteger::BigInteger b = Biginteger::from_string(big_num2);
-    
-    auto start = std::chrono::high_resolution_clock::now();
-    // Biginteger::BigInteger c1 = Biginteger::multiply_abs(a, b);  // 普通乘法
-    Biginteger::BigInteger c1 = a * b;
-    auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "Normal: " 
-            << std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()
-            << "ms\n";
-
-    start = std::chrono::high_resolution_clock::now();
-    Biginteger::BigInteger c4 = FFT_multiply(a, b);  // FFT
-    end = std::chrono::high_resolution_clock::now();
-    std::cout << "FFT_multiply: " 
-              << std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()
-              << "ms\n";
-}
+#include <chrono>
+#include <cstring>
+#include <fstream>
 
 void test_division() {
 
@@ -70,7 +46,76 @@ void test_division() {
 
 }
 
-int main() {
+// 批量模式：high-precision --batch [文件]，每行一个表达式，省略文件时读标准输入
+int run_batch(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+    if (argc < 3) {
+        Biginteger::evaluate_stream(std::cin, std::cout);
+        return 0;
+    }
+    std::ifstream in(argv[2]);
+    if (!in) {
+        std::cerr << "cannot open " << argv[2] << "\n";
+        return 1;
+    }
+    Biginteger::evaluate_stream(in, std::cout);
+    return 0;
+}
+
+// 常数模式：high-precision --constant <pi|e|log2|sqrt2> <位数> [--checkpoint 文件] [--out 文件]
+// 结果写到标准输出或 --out 指定的文件，耗时写到标准错误
+int run_constant(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "usage: high-precision --constant <pi|e|log2|sqrt2> <digits> [--checkpoint file] [--out file]\n";
+        return 1;
+    }
+
+    try {
+        std::string checkpoint, output;
+        for (int i = 4; i < argc; ++i) {
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::invalid_argument(std::string("Missing value for ") + argv[i]);
+                return argv[++i];
+            };
+            if (std::strcmp(argv[i], "--checkpoint") == 0) checkpoint = value();
+            else if (std::strcmp(argv[i], "--out") == 0) output = value();
+            else throw std::invalid_argument(std::string("Unknown option: ") + argv[i]);
+        }
+
+        // 位数只接受十进制数字，std::stoull 会放过符号和尾部的多余字符
+        const std::string count = argv[3];
+        if (count.empty() || count.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("Invalid digit count: " + count);
+        }
+        const Biginteger::Constant c = Biginteger::constant_from_name(argv[2]);
+        const size_t digits = std::stoull(count);
+        const auto start = std::chrono::steady_clock::now();
+        const std::string value = Biginteger::constant_string(c, digits, checkpoint);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (output.empty()) {
+            std::cout << value << "\n";
+        } else {
+            std::ofstream out(output);
+            if (!(out << value << "\n")) {
+                std::cerr << "cannot write " << output << "\n";
+                return 1;
+            }
+        }
+        std::cerr << argv[2] << ": " << digits << " digits in " << seconds << " s\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0)
+        return run_batch(argc, argv);
+    if (argc > 1 && std::strcmp(argv[1], "--constant") == 0)
+        return run_constant(argc, argv);
+
     // 测试用例
     Biginteger::BigInteger a = Biginteger::from_string("123");
     Biginteger::BigInteger b = Biginteger::from_string("-456");
@@ -107,7 +152,7 @@ int main() {
     std::cout << "-123 / 10 = " << Biginteger::divide_decimal(neg, ten, 1) << "\n"; // 输出-12.3
     // 表达式解析测试
     std::cout << "Parsing and evaluating expressions:" << std::endl;
-    std::cout << "5 / 2 = " << Biginteger::evaluate_expression("5 / 2") << std::endl;       // 输出2.5
+    std::cout << "5 / 2 = " << Biginteger::evaluate_expression("5 / 2") << std::endl;       // 输出2
     std::cout << "123 + 456 = " << Biginteger::evaluate_expression("123 + 456") << std::endl; // 输出579
     std::cout << "-123 * 10 = " << Biginteger::evaluate_expression("-123 * 10") << std::endl; // 输出-1230
     std::cout << "100 - 50 = " << Biginteger::evaluate_expression("100 - 50") << std::endl;   // 输出50
@@ -127,11 +172,10 @@ int main() {
               << evaluate_expression("max(5, 3*4, 10-2)") << "\n"; // 输出8
 
     std::cout << "Test 5: (100 // 3) / 4 = "
-              << evaluate_expression("(100 // 3) / 4") << "\n"; // 输出8.3333333333
+              << evaluate_expression("(100 // 3) / 4") << "\n"; // 输出8
 
     return 0;
     return 0;
-    // benchmark();
     // test_division();
     return 0;
 }
\ No newline at end of file
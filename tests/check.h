@@ -0,0 +1,96 @@
+#pragma once
+
+#include <BigInteger/biginteger.h>
+#include <random>
+
+// 测试共用的断言与随机数：CHECK 失败时打印位置并计数，不中止，main 以 check_result() 作为返回值。
+// 不依赖 assert，Release 构建下同样生效
+
+inline int& check_failures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline int check_result() {
+    if (check_failures()) std::cerr << check_failures() << " check(s) failed\n";
+    return check_failures() ? 1 : 0;
+}
+
+#define CHECK(cond)                                                                       \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed\n";    \
+            ++check_failures();                                                           \
+        }                                                                                 \
+    } while (0)
+
+// 期望抛出 Exception
+#define CHECK_THROWS(expr, Exception)                                                     \
+    do {                                                                                  \
+        bool thrown = false;                                                              \
+        try {                                                                             \
+            (void)(expr);                                                                 \
+        } catch (const Exception&) {                                                      \
+            thrown = true;                                                                \
+        }                                                                                 \
+        if (!thrown) {                                                                    \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #expr " did not throw\n";    \
+            ++check_failures();                                                           \
+        }                                                                                 \
+    } while (0)
+
+// 恰好 limbs 个 limb 的随机正数；sparse 为真时多数 limb 取 0 或 BASE - 1，容易触发进位与借位的边界
+inline Biginteger::BigInteger random_number(std::mt19937_64& rng, size_t limbs, bool sparse = false) {
+    using namespace Biginteger;
+    BigInteger num;
+    num.digits.resize(limbs);
+    for (auto& limb : num.digits) {
+        const uint64_t r = rng();
+        limb = sparse && r % 4 != 0 ? (r % 8 < 4 ? 0 : BASE - 1) : (limb_t)(r % BASE);
+    }
+    if (num.digits.back() == 0) num.digits.back() = 1;
+    return num;
+}
+
+// 规范形式：没有前导零，零不带负号
+inline bool canonical(const Biginteger::BigInteger& x) {
+    if (x.digits.empty()) return false;
+    if (x.digits.size() > 1 && x.digits.back() == 0) return false;
+    return !(x.is_negative && Biginteger::is_zero(x));
+}
+
+// 规范形式且值、符号都与 expected 相同
+inline bool identical(const Biginteger::BigInteger& x, const Biginteger::BigInteger& expected) {
+    return canonical(x) && x == expected && x.is_negative == expected.is_negative;
+}
+
+// 恢复全部阈值，供在同一进程里切换配置的测试使用
+struct ThresholdGuard {
+    Biginteger::Thresholds saved = Biginteger::thresholds();
+    ~ThresholdGuard() { Biginteger::thresholds() = saved; }
+};
+
+// 逐 limb 的竖式乘法，不经过库里的任何乘法路径，用来核对乘积
+inline Biginteger::BigInteger reference_multiply(const Biginteger::BigInteger& a, const Biginteger::BigInteger& b) {
+    using namespace Biginteger;
+    std::vector<uint64_t> acc(a.digits.size() + b.digits.size() + 1, 0);
+    for (size_t i = 0; i < a.digits.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.digits.size(); ++j) {
+            const uint64_t cur = acc[i + j] + (uint64_t)a.digits[i] * b.digits[j] + carry;
+            acc[i + j] = cur % BASE;
+            carry = cur / BASE;
+        }
+        for (size_t k = i + b.digits.size(); carry != 0; ++k) {
+            const uint64_t cur = acc[k] + carry;
+            acc[k] = cur % BASE;
+            carry = cur / BASE;
+        }
+    }
+    BigInteger result;
+    result.digits.resize(acc.size());
+    for (size_t i = 0; i < acc.size(); ++i) result.digits[i] = (limb_t)acc[i];
+    remove_leading_zeros(result);
+    result.is_negative = a.is_negative != b.is_negative && !is_zero(result);
+    return result;
+}
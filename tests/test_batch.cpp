@@ -0,0 +1,38 @@
+#include "check.h"
+
+#include <sstream>
+
+// 批量与流式求值：结果按输入顺序对应，出错的项只影响自己
+
+using namespace Biginteger;
+
+int main() {
+    const size_t threads = thread_count();
+    set_thread_count(3);
+
+    std::vector<std::string> exprs;
+    for (int i = 0; i < 100; ++i) exprs.push_back(std::to_string(i) + " * " + std::to_string(i) + " - 1");
+    exprs[40] = "1 / 0";
+    exprs[41] = "2 +";
+    const std::vector<BatchResult> results = evaluate_batch(exprs);
+    CHECK(results.size() == exprs.size());
+    for (int i = 0; i < 100; ++i) {
+        if (i == 40 || i == 41) continue;
+        CHECK(results[i].ok && results[i].value == from_longlong((long long)i * i - 1));
+    }
+
+    // 出错的项 value 为 0，可以直接输出
+    CHECK(!results[40].ok && !results[40].error.empty());
+    CHECK(!results[41].ok && results[41].value == from_longlong(0));
+    std::ostringstream printed;
+    printed << evaluate_batch({"1/0"})[0].value;
+    CHECK(printed.str() == "0");
+
+    std::istringstream in("1 + 1\n\n2 * 3\n1 / 0\n10 // 3\n");
+    std::ostringstream out;
+    evaluate_stream(in, out, 2);
+    CHECK(out.str() == "2\n\n6\nerror: Division by zero\n3\n");
+
+    set_thread_count(threads);
+    return check_result();
+}
@@ -0,0 +1,42 @@
+#include "check.h"
+
+#include <filesystem>
+
+// 数学常数：前 50 位与已知值比较，不同位数的结果互为前缀，检查点续算、截断与参数不符时从头开始
+
+using namespace Biginteger;
+
+int main() {
+    CHECK(constant_string(Constant::Pi, 50) == "3.14159265358979323846264338327950288419716939937510");
+    CHECK(constant_string(Constant::E, 50) == "2.71828182845904523536028747135266249775724709369995");
+    CHECK(constant_string(Constant::Log2, 50) == "0.69314718055994530941723212145817656807550013436025");
+    CHECK(constant_string(Constant::Sqrt2, 50) == "1.41421356237309504880168872420969807856967187537694");
+    CHECK(constant_string(Constant::Pi, 0) == "3");
+    CHECK(constant_string(Constant::Log2, 1) == "0.6");
+    CHECK(compute_constant(Constant::E, 3) == from_longlong(2718));
+
+    for (Constant c : {Constant::Pi, Constant::E, Constant::Log2, Constant::Sqrt2}) {
+        CHECK(constant_from_name(constant_name(c)) == c);
+        const std::string shorter = constant_string(c, 3000), longer = constant_string(c, 12345);
+        CHECK(longer.compare(0, shorter.size(), shorter) == 0);
+    }
+    CHECK_THROWS(constant_from_name("tau"), std::invalid_argument);
+
+    // 分成多段的级数：首次运行写入检查点，重跑直接读回；截掉最后一条记录后重算合并结果并补回
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "biginteger_test_checkpoint.bin";
+    std::filesystem::remove(path);
+    const BigInteger expected = compute_constant(Constant::Log2, 20000);
+    CHECK(compute_constant(Constant::Log2, 20000, path.string()) == expected);
+    const uintmax_t size = std::filesystem::file_size(path);
+    CHECK(compute_constant(Constant::Log2, 20000, path.string()) == expected);
+    CHECK(std::filesystem::file_size(path) == size);
+    std::filesystem::resize_file(path, size - 5);
+    CHECK(compute_constant(Constant::Log2, 20000, path.string()) == expected);
+    CHECK(std::filesystem::file_size(path) == size);
+
+    // 位数不同的文件从头开始
+    CHECK(compute_constant(Constant::E, 15000, path.string()) == compute_constant(Constant::E, 15000));
+    CHECK(compute_constant(Constant::Log2, 20000, path.string()) == expected);
+    std::filesystem::remove(path);
+    return check_result();
+}
@@ -0,0 +1,71 @@
+#include "check.h"
+
+// 十进制展开：和 a · 10^p / b 的整数商比较，覆盖一次除法即可的短精度、按块用 Newton 倒数的长精度、
+// 提前终止的展开、符号与零，以及交给 sink 的分段
+
+using namespace Biginteger;
+
+// 符号、整数部分与 p 位小数；余数为零时去掉小数末尾的零，没有小数时也不写小数点
+static std::string reference(const BigInteger& a, const BigInteger& b, size_t p) {
+    BigInteger rem;
+    const BigInteger scaled = divide(absolute(a) * from_string("1" + std::string(p, '0')), absolute(b), rem);
+    std::string digits = to_string(scaled);
+    if (digits.size() <= p) digits.insert(0, p + 1 - digits.size(), '0');
+    std::string whole = digits.substr(0, digits.size() - p), fraction = digits.substr(digits.size() - p);
+    if (rem == from_longlong(0)) fraction.erase(fraction.find_last_not_of('0') + 1);
+    const bool negative = a.is_negative != b.is_negative && !(a == from_longlong(0));
+    return (negative ? "-" : "") + whole + (fraction.empty() ? "" : "." + fraction);
+}
+
+int main() {
+    std::mt19937_64 rng(18);
+
+    CHECK(divide_decimal(from_longlong(1), from_longlong(8), 10) == "0.125");
+    CHECK(divide_decimal(from_longlong(1), from_longlong(8), 2) == "0.12");
+    CHECK(divide_decimal(from_longlong(10), from_longlong(3), 3) == "3.333");
+    CHECK(divide_decimal(from_longlong(-123), from_longlong(10), 1) == "-12.3");
+    CHECK(divide_decimal(from_longlong(-1), from_longlong(3), 2) == "-0.33");
+    CHECK(divide_decimal(from_longlong(1), from_longlong(-3), 0) == "-0");
+    CHECK(divide_decimal(from_longlong(-6), from_longlong(-3), 5) == "2");
+    CHECK(divide_decimal(from_longlong(0), from_longlong(-7), 5) == "0");
+    CHECK(divide_decimal(from_longlong(101), from_longlong(100), 1) == "1.0");
+    CHECK(divide_decimal(from_longlong(5), from_longlong(2), -3) == "2");
+    CHECK_THROWS(divide_decimal(from_longlong(5), from_longlong(0), 3), std::invalid_argument);
+
+    // 除数 n 个 limb：p 不超过 9n 位时一次除法，否则每块 max(n, 512) 个 limb
+    for (size_t n : {1, 3, 100, 600}) {
+        for (size_t p : {size_t(1), 9 * n - 4, 9 * n + 1, size_t(20000)}) {
+            BigInteger a = random_number(rng, 1 + rng() % (2 * n)), b = random_number(rng, n, rng() % 2);
+            a.is_negative = rng() % 2;
+            b.is_negative = rng() % 2;
+            CHECK(divide_decimal(a, b, (int)p) == reference(a, b, p));
+        }
+    }
+
+    // 展开在某一块中间终止：分母只含因子 2 和 5 时不补零
+    const BigInteger two_power = from_string("1" + std::string(30, '0')) * from_longlong(1 << 20);
+    for (size_t p : {size_t(10), size_t(40), size_t(10000)})
+        CHECK(divide_decimal(from_longlong(7), two_power, (int)p) == reference(from_longlong(7), two_power, p));
+    const BigInteger power = from_string("1" + std::string(6000, '0'));
+    CHECK(divide_decimal(from_longlong(3), power * from_longlong(8), 9000) == "0." + std::string(6000, '0') + "375");
+
+    // 分段：符号、整数部分、小数点，然后每块 512 个 limb 即 4608 位，最后一块截到剩下的位数
+    std::vector<std::string> pieces;
+    divide_decimal_stream(from_longlong(-22), from_longlong(7), 10000,
+                          [&](std::string_view part) { pieces.emplace_back(part); });
+    CHECK(pieces.size() == 6);
+    if (pieces.size() == 6) {
+        CHECK(pieces[0] == "-" && pieces[1] == "3" && pieces[2] == ".");
+        CHECK(pieces[3].size() == 4608 && pieces[4].size() == 4608 && pieces[5].size() == 10000 - 2 * 4608);
+    }
+    std::string joined;
+    for (const auto& part : pieces) joined += part;
+    CHECK(joined == reference(from_longlong(-22), from_longlong(7), 10000));
+
+    // 整除时只有整数部分
+    pieces.clear();
+    divide_decimal_stream(from_longlong(21), from_longlong(7), 100,
+                          [&](std::string_view part) { pieces.emplace_back(part); });
+    CHECK(pieces == std::vector<std::string>{"3"});
+    return check_result();
+}
@@ -0,0 +1,77 @@
+#include "check.h"
+
+// 各级除法都满足 a = q * b + r、0 <= r < b；阈值调低后 Burnikel–Ziegler 与 Newton 在小规模上也会递归多层
+
+using namespace Biginteger;
+
+using Divide = BigInteger (*)(const BigInteger&, const BigInteger&, BigInteger&);
+
+static void check_division(Divide divide, const BigInteger& a, const BigInteger& b) {
+    BigInteger r;
+    const BigInteger q = divide(a, b, r);
+    CHECK(q * b + r == a);
+    CHECK(!r.is_negative && compare_abs(r, b) < 0);
+}
+
+static void check_all(std::mt19937_64& rng, size_t na, size_t nb) {
+    const BigInteger a = random_number(rng, na, rng() % 2), b = random_number(rng, nb, rng() % 2);
+    for (Divide divide : {divide_knuth, divide_bz, divide_newton, divide_abs}) {
+        check_division(divide, a, b);
+        // 整除与余数为 b - 1 的情形
+        check_division(divide, a * b, b);
+        check_division(divide, a * b + b - 1, b);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(11);
+
+    ThresholdGuard guard;
+    thresholds().karatsuba = 8;
+    thresholds().toom3 = thresholds().toom4 = 32;
+    thresholds().fft = 64;
+    thresholds().bz = 4;
+    thresholds().newton = 16;
+
+    // 平衡、商很短、除数很短的形状
+    const size_t shapes[][2] = {{1, 1}, {2, 1}, {8, 4}, {16, 15}, {40, 17}, {64, 32}, {100, 3},
+                                {129, 64}, {300, 150}, {301, 299}, {500, 20}, {1000, 333}};
+    for (const auto& s : shapes)
+        for (int i = 0; i < 3; ++i) check_all(rng, s[0], s[1]);
+    for (int i = 0; i < 40; ++i) {
+        const size_t nb = 1 + rng() % 300, na = nb + rng() % 400;
+        check_all(rng, na, nb);
+    }
+
+    // 除数为 BASE^k - 1 时估商最容易偏大；a < b 时商为零
+    for (size_t k : {5, 33, 200}) {
+        const BigInteger b = power_of_base(k) - 1;
+        for (Divide divide : {divide_knuth, divide_bz, divide_newton}) {
+            check_division(divide, power_of_base(3 * k) - 1, b);
+            check_division(divide, power_of_base(2 * k + 7), b);
+            BigInteger r;
+            CHECK(divide(b - 1, b, r) == from_longlong(0) && r == b - 1);
+        }
+    }
+
+    // reciprocal(b) = floor(BASE^(2n) / b)
+    for (size_t n : {3, 20, 64, 257}) {
+        const BigInteger b = random_number(rng, n, rng() % 2);
+        const BigInteger x = reciprocal(b);
+        const BigInteger r = power_of_base(2 * n) - x * b;
+        CHECK(!r.is_negative && compare_abs(r, b) < 0);
+    }
+
+    // 带符号的除法向零截断，余数与被除数同号
+    const BigInteger a = random_number(rng, 90), b = random_number(rng, 40);
+    BigInteger r;
+    for (int sign = 0; sign < 4; ++sign) {
+        const BigInteger x = sign & 1 ? negate(a) : a, y = sign & 2 ? negate(b) : b;
+        const BigInteger q = divide(x, y, r);
+        CHECK(q * y + r == x);
+        CHECK(r.is_negative == x.is_negative);
+        CHECK(q.is_negative == (x.is_negative != y.is_negative));
+    }
+    CHECK_THROWS(divide(a, from_longlong(0), r), std::invalid_argument);
+    return check_result();
+}
@@ -0,0 +1,56 @@
+#include "check.h"
+
+#include <atomic>
+#include <functional>
+
+// 预编译表达式：语法、常量折叠、变量绑定，以及在并行乘法内部嵌套求值时寄存器互不干扰
+
+using namespace Biginteger;
+
+static BigInteger run(const std::string& text, const std::vector<BigInteger>& bindings = {}) {
+    return evaluate(compile(text), bindings);
+}
+
+int main() {
+    CHECK(run("1 + 2 * 3") == from_longlong(7));
+    CHECK(run("(1 + 2) * 3 - -4") == from_longlong(13));
+    CHECK(run("7 / 2") == from_longlong(3));
+    CHECK(run("7 // 2") == from_longlong(3));
+    CHECK(run("-7 // 2") == from_longlong(-3));
+    CHECK(run("sum(1, 2, 3) * max(4, -5, 2)") == from_longlong(24));
+    CHECK(run("123456789123456789 * 987654321987654321") ==
+          from_string("121932631356500531347203169112635269"));
+
+    // "//" 中间不能有空白，两个除号之间缺少操作数
+    CHECK_THROWS(compile("7 / / 2"), std::invalid_argument);
+    CHECK_THROWS(compile("7 /"), std::invalid_argument);
+    CHECK_THROWS(compile("(1 + 2"), std::invalid_argument);
+    CHECK_THROWS(run("1 / 0"), std::invalid_argument);
+
+    const CompiledExpression f = compile("x * x + y // 3 - x");
+    CHECK(f.variables.size() == 2 && variable_index(f, "y") == 1);
+    CHECK(evaluate(f, {from_longlong(5), from_longlong(10)}) == from_longlong(23));
+    CHECK_THROWS(evaluate(f, {from_longlong(5)}), std::invalid_argument);
+    CHECK_THROWS(variable_index(f, "z"), std::invalid_argument);
+
+    // 乘法的并行子任务里再次求值：每次求值有自己的寄存器帧，外层的中间结果不受影响
+    const size_t threads = thread_count();
+    set_thread_count(4);
+    ThresholdGuard guard;
+    thresholds().parallel = 8;
+    thresholds().karatsuba = 8;
+    std::mt19937_64 rng(17);
+    const BigInteger a = random_number(rng, 300), b = random_number(rng, 280);
+    const CompiledExpression g = compile("(a + 1) * (b - 1) + a * b");
+    const BigInteger expected = (a + 1) * (b - 1) + a * b;
+    std::atomic<int> wrong{0};
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 16; ++i)
+        tasks.push_back([&] {
+            if (!(evaluate(g, {a, b}) == expected)) wrong.fetch_add(1);
+        });
+    parallel_invoke(tasks, PARALLEL_THRESHOLD);
+    CHECK(wrong.load() == 0);
+    set_thread_count(threads);
+    return check_result();
+}
@@ -0,0 +1,22 @@
+#include "check.h"
+
+// double FFT 乘法与竖式乘法比较，包括平方与相差悬殊的操作数
+
+using namespace Biginteger;
+
+int main() {
+    std::mt19937_64 rng(13);
+
+    const size_t sizes[] = {1, 2, 5, 64, 333, 1024, 3000};
+    for (size_t na : sizes) {
+        for (size_t nb : sizes) {
+            const BigInteger a = random_number(rng, na, rng() % 2), b = random_number(rng, nb, rng() % 2);
+            CHECK(FFT_multiply(a, b) == multiply_abs(a, b));
+            CHECK(FFT_multiply(negate(a), b) == negate(multiply_abs(a, b)));
+        }
+        const BigInteger a = random_number(rng, na, true);
+        CHECK(FFT_multiply(a, a) == multiply_abs(a, a));
+    }
+    CHECK(FFT_multiply(from_longlong(0), random_number(rng, 10)) == from_longlong(0));
+    return check_result();
+}
@@ -0,0 +1,92 @@
+#include "check.h"
+
+#include <limits>
+
+// gcd、xgcd 与 modinv：Bézout 等式与整除性，分别在默认阈值、只用 Lehmer、以及把半 GCD 递归压到很短时检查
+
+using namespace Biginteger;
+
+static bool divides(const BigInteger& d, const BigInteger& x) {
+    return x % d == from_longlong(0);
+}
+
+// g 整除 a、b，s a + t b = g，且 a / g 与 b / g 互素
+static void check_pair(const BigInteger& a, const BigInteger& b) {
+    const BigInteger g = gcd(a, b);
+    BigInteger s, t;
+    CHECK(xgcd(a, b, s, t) == g);
+    CHECK(s * a + t * b == g);
+    CHECK(!g.is_negative);
+    if (!(g == from_longlong(0))) {
+        CHECK(divides(g, a) && divides(g, b));
+        CHECK(gcd(a / g, b / g) == from_longlong(1));
+        if (!(b == from_longlong(0))) CHECK(compare_abs(s, absolute(b) / g) < 0);
+    }
+}
+
+static void run_all(std::mt19937_64& rng) {
+    for (size_t n : {1, 2, 3, 10, 40, 150, 600}) {
+        const BigInteger common = random_number(rng, n / 3 + 1);
+        const BigInteger a = random_number(rng, n, rng() % 2), b = random_number(rng, n - n / 4, rng() % 2);
+        check_pair(a, b);
+        check_pair(a * common, b * common);
+        check_pair(negate(a * common), b);
+        check_pair(a, negate(b * common));
+        CHECK(divides(common, gcd(a * common, b * common)));
+    }
+
+    // 相邻的 Fibonacci 数：每步商都是 1，是欧几里得算法最慢的输入
+    BigInteger f0 = from_longlong(0), f1 = from_longlong(1);
+    for (int i = 0; i < 20000; ++i) {
+        BigInteger f2 = f0 + f1;
+        f0 = std::move(f1);
+        f1 = std::move(f2);
+    }
+    check_pair(f1, f0);
+    CHECK(gcd(f1, f0) == from_longlong(1));
+}
+
+int main() {
+    std::mt19937_64 rng(22);
+
+    CHECK(gcd(from_longlong(0), from_longlong(0)) == from_longlong(0));
+    CHECK(gcd(from_longlong(-12), from_longlong(0)) == from_longlong(12));
+    CHECK(gcd(from_longlong(0), from_longlong(-12)) == from_longlong(12));
+    CHECK(gcd(from_longlong(-12), from_longlong(18)) == from_longlong(6));
+    check_pair(from_longlong(0), from_longlong(0));
+    check_pair(from_longlong(-7), from_longlong(0));
+    check_pair(from_longlong(0), from_longlong(9));
+    check_pair(from_longlong(240), from_longlong(46));
+
+    run_all(rng);
+    {
+        ThresholdGuard guard;
+        thresholds().hgcd = std::numeric_limits<size_t>::max();
+        run_all(rng);
+    }
+    {
+        ThresholdGuard guard;
+        thresholds().hgcd = 8;
+        thresholds().karatsuba = 8;
+        run_all(rng);
+    }
+
+    // 模逆：结果在 [0, m)，负数先化到 [0, m)，不互素时抛出异常
+    for (size_t n : {1, 3, 50, 300}) {
+        BigInteger m = random_number(rng, n);
+        if (m.digits[0] % 2 == 0) m.digits[0] += 1;
+        const BigInteger a = random_number(rng, n + 2) * from_longlong(2);
+        if (!(gcd(a, m) == from_longlong(1))) continue;
+        const BigInteger inv = modinv(a, m);
+        CHECK(!inv.is_negative && compare_abs(inv, m) < 0);
+        CHECK(inv * a % m == from_longlong(1) % m);
+        const BigInteger neg = modinv(negate(a), m);
+        CHECK((neg + inv) % m == from_longlong(0));
+    }
+    CHECK(modinv(from_longlong(3), from_longlong(1)) == from_longlong(0));
+    CHECK(modinv(from_longlong(3), from_longlong(7)) == from_longlong(5));
+    CHECK_THROWS(modinv(from_longlong(6), from_longlong(9)), std::invalid_argument);
+    CHECK_THROWS(modinv(from_longlong(3), from_longlong(0)), std::invalid_argument);
+    CHECK_THROWS(modinv(from_longlong(3), from_longlong(-7)), std::invalid_argument);
+    return check_result();
+}
@@ -0,0 +1,167 @@
+#include "check.h"
+
+// 写入已有对象的 add/sub/mul：out 与 a、b 各种重合方式；右值运算符与复合赋值，包括 /=、%= 的符号。
+// 结果和按值返回的运算符比较，乘法另与竖式乘法比较，除法另核对 q · b + r = a 与截断方向
+
+using namespace Biginteger;
+
+enum class Op { Add, Sub, Mul };
+
+static void apply(Op op, BigInteger& out, const BigInteger& a, const BigInteger& b) {
+    if (op == Op::Add) add(out, a, b);
+    else if (op == Op::Sub) sub(out, a, b);
+    else mul(out, a, b);
+}
+
+static BigInteger expected(Op op, const BigInteger& a, const BigInteger& b) {
+    if (op == Op::Add) return a + b;
+    if (op == Op::Sub) return a - b;
+    return reference_multiply(a, b);
+}
+
+// out 与 a、b 不同，或是 a、b 之一，或三者是同一个对象
+static void check_aliasing(std::mt19937_64& rng, const BigInteger& a, const BigInteger& b) {
+    for (Op op : {Op::Add, Op::Sub, Op::Mul}) {
+        const BigInteger ab = expected(op, a, b), aa = expected(op, a, a);
+        if (op == Op::Mul) CHECK(a * b == ab);
+
+        BigInteger out = random_number(rng, 1 + rng() % 20);
+        out.is_negative = rng() % 2;
+        apply(op, out, a, b);
+        CHECK(identical(out, ab));
+
+        BigInteger x = a;
+        apply(op, x, x, b);
+        CHECK(identical(x, ab));
+
+        BigInteger y = b;
+        apply(op, y, a, y);
+        CHECK(identical(y, ab));
+
+        BigInteger z = a;
+        apply(op, z, z, z);
+        CHECK(identical(z, aa));
+
+        BigInteger w;
+        apply(op, w, a, a);
+        CHECK(identical(w, aa));
+    }
+}
+
+// 截断除法：商向零取整，余数与被除数同号
+static void check_division(const BigInteger& a, const BigInteger& b) {
+    const BigInteger q = a / b, r = a % b;
+    CHECK(canonical(q) && canonical(r));
+    CHECK(q * b + r == a);
+    CHECK(absolute(r) < absolute(b));
+    CHECK(r == from_longlong(0) || r.is_negative == a.is_negative);
+    CHECK(q == from_longlong(0) || q.is_negative == (a.is_negative != b.is_negative));
+
+    BigInteger x = a;
+    x /= b;
+    CHECK(identical(x, q));
+    x = a;
+    x %= b;
+    CHECK(identical(x, r));
+    BigInteger y = b;
+    y /= y;
+    CHECK(identical(y, from_longlong(1)));
+    y = b;
+    y %= y;
+    CHECK(identical(y, from_longlong(0)));
+}
+
+int main() {
+    std::mt19937_64 rng(13);
+
+    // 长度跨过单 limb 的原地路径、Karatsuba、Toom 与 FFT 阈值；每对都试四种符号
+    const std::pair<size_t, size_t> shapes[] = {{1, 1}, {1, 5}, {7, 1}, {3, 3}, {9, 4}, {60, 50}, {140, 130}, {300, 270}, {500, 40}};
+    for (auto [na, nb] : shapes) {
+        const BigInteger ma = random_number(rng, na, rng() % 2), mb = random_number(rng, nb, rng() % 2);
+        for (int signs = 0; signs < 4; ++signs) {
+            BigInteger a = ma, b = mb;
+            a.is_negative = signs & 1;
+            b.is_negative = signs & 2;
+            check_aliasing(rng, a, b);
+            check_aliasing(rng, b, a);
+        }
+    }
+
+    // 零、互为相反数、相等：结果为零时不带负号
+    {
+        const BigInteger zero = from_longlong(0), a = random_number(rng, 12);
+        const BigInteger minus_a = negate(a);
+        check_aliasing(rng, zero, a);
+        check_aliasing(rng, minus_a, zero);
+        check_aliasing(rng, a, minus_a);
+        BigInteger x = a;
+        add(x, x, minus_a);
+        CHECK(identical(x, zero));
+        x = minus_a;
+        sub(x, x, x);
+        CHECK(identical(x, zero));
+        x = minus_a;
+        mul(x, x, zero);
+        CHECK(identical(x, zero));
+    }
+
+    // 右值运算符复用临时对象的缓冲区，结果与常量引用版本一致；长链逐步比较
+    for (auto [na, nb] : shapes) {
+        BigInteger a = random_number(rng, na), b = random_number(rng, nb), c = random_number(rng, nb + 2);
+        a.is_negative = rng() % 2;
+        b.is_negative = rng() % 2;
+        c.is_negative = rng() % 2;
+        const BigInteger sum = a + b, diff = a - b;
+        CHECK(identical(BigInteger(a) + b, sum));
+        CHECK(identical(a + BigInteger(b), sum));
+        CHECK(identical(BigInteger(a) + BigInteger(b), sum));
+        CHECK(identical(BigInteger(a) - b, diff));
+        CHECK(identical(a - BigInteger(b), diff));
+        CHECK(identical(BigInteger(a) - BigInteger(b), diff));
+        CHECK(identical(a + b + c - a - b, c));
+        CHECK(identical(a - (b + c) + (c - a), negate(b)));
+        CHECK(identical(a * b + c - b * a, c));
+
+        BigInteger x = a;
+        x += b;
+        CHECK(identical(x, sum));
+        x -= b;
+        CHECK(identical(x, a));
+        x *= b;
+        CHECK(identical(x, reference_multiply(a, b)));
+        x = a;
+        x += x;
+        CHECK(identical(x, a + a));
+        x -= x;
+        CHECK(identical(x, from_longlong(0)));
+        x = a;
+        x *= x;
+        CHECK(identical(x, reference_multiply(a, a)));
+    }
+
+    // 除法：与 C++ 整数的截断语义一致，/= 与 %= 和按值版本一致
+    for (long long n : {7LL, -7LL, 6LL, -6LL, 0LL, 1000000007LL, -999999999999LL}) {
+        for (long long d : {2LL, -2LL, 3LL, -3LL, 1LL, -1LL, 1000000000LL, -123456789012LL}) {
+            const BigInteger a = from_longlong(n), b = from_longlong(d);
+            CHECK(identical(a / b, from_longlong(n / d)));
+            CHECK(identical(a % b, from_longlong(n % d)));
+            check_division(a, b);
+        }
+    }
+    // 除数跨过 Burnikel–Ziegler 阈值，被除数短于、等于、长于除数
+    for (auto [na, nb] : {std::pair<size_t, size_t>{5, 2}, {40, 40}, {3, 9}, {400, 150}, {700, 300}}) {
+        const BigInteger ma = random_number(rng, na, rng() % 2), mb = random_number(rng, nb);
+        for (int signs = 0; signs < 4; ++signs) {
+            BigInteger a = ma, b = mb;
+            a.is_negative = signs & 1;
+            b.is_negative = signs & 2;
+            check_division(a, b);
+            // 整除时余数为零
+            check_division(a * b, b);
+        }
+    }
+    BigInteger x = from_longlong(5);
+    CHECK_THROWS(x /= from_longlong(0), std::invalid_argument);
+    CHECK_THROWS(x %= from_longlong(0), std::invalid_argument);
+    return check_result();
+}
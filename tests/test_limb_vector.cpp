@@ -0,0 +1,182 @@
+#include "check.h"
+
+#include <iterator>
+
+// LimbVector：跨过 INLINE_LIMBS 的增长、来自自身或 uint64_t 的区间赋值、内部与堆上缓冲区之间的移动和交换，
+// 每一步都和 std::vector 的内容比较
+
+using namespace Biginteger;
+
+using Model = std::vector<limb_t>;
+
+static bool same(const LimbVector& v, const Model& m) {
+    return v.size() == m.size() && std::equal(v.begin(), v.end(), m.begin());
+}
+
+static LimbVector make(size_t n, limb_t first) {
+    LimbVector v;
+    for (size_t i = 0; i < n; ++i) v.push_back(first + (limb_t)i);
+    return v;
+}
+
+static Model model(size_t n, limb_t first) {
+    Model m;
+    for (size_t i = 0; i < n; ++i) m.push_back(first + (limb_t)i);
+    return m;
+}
+
+// 在 v 的前 period 个元素上循环读出 count 个值：区间比 v 的容量长，但每个元素都来自 v 自身
+struct Cycle {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = limb_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const limb_t*;
+    using reference = const limb_t&;
+
+    const limb_t* base;
+    size_t period, index;
+
+    reference operator*() const { return base[index % period]; }
+    Cycle& operator++() { ++index; return *this; }
+    difference_type operator-(const Cycle& other) const { return (difference_type)index - (difference_type)other.index; }
+    bool operator==(const Cycle& other) const { return index == other.index; }
+    bool operator!=(const Cycle& other) const { return index != other.index; }
+};
+
+int main() {
+    const size_t INLINE = LimbVector::INLINE_LIMBS;
+
+    // 逐个 push_back：前 INLINE 个留在内部缓冲区，之后搬到堆上并按倍数增长
+    {
+        LimbVector v;
+        Model m;
+        CHECK(v.empty() && v.capacity() == INLINE);
+        const limb_t* inline_data = v.data();
+        for (limb_t i = 0; i < 100; ++i) {
+            v.push_back(i * 7);
+            m.push_back(i * 7);
+            CHECK(same(v, m) && v.capacity() >= v.size());
+            CHECK((v.size() <= INLINE) == (v.data() == inline_data));
+        }
+        v.pop_back();
+        m.pop_back();
+        CHECK(same(v, m));
+    }
+
+    // resize 跨过边界时新元素取给定值，缩小后再放大也要重新填充
+    for (size_t n : {INLINE - 1, INLINE, INLINE + 1, 3 * INLINE}) {
+        LimbVector v = make(3, 10);
+        Model m = model(3, 10);
+        v.resize(n, 5);
+        m.resize(n, 5);
+        CHECK(same(v, m));
+        v.resize(1);
+        m.resize(1);
+        v.resize(n + 2, 9);
+        m.resize(n + 2, 9);
+        CHECK(same(v, m));
+        v.assign(n, 4);
+        CHECK(same(v, Model(n, 4)));
+    }
+    {
+        LimbVector v = {1, 2, 3};
+        v.reserve(50);
+        CHECK(v.capacity() >= 50 && same(v, {1, 2, 3}));
+        v.clear();
+        CHECK(v.empty() && v.capacity() >= 50);
+    }
+
+    // 区间来自自身：缩短时原地前移；超出容量时必须先复制再释放旧缓冲区
+    for (size_t n : {INLINE - 2, INLINE, INLINE + 3, size_t(40)}) {
+        LimbVector v = make(n, 100);
+        v.assign(v.begin() + 2, v.end());
+        CHECK(same(v, model(n - 2, 102)));
+        v.assign(v.begin(), v.end());
+        CHECK(same(v, model(n - 2, 102)));
+
+        v = make(n, 100);
+        const size_t count = v.capacity() * 3 + 1;
+        v.assign(Cycle{v.data(), n, 0}, Cycle{v.data(), n, count});
+        Model expected;
+        for (size_t i = 0; i < count; ++i) expected.push_back(100 + (limb_t)(i % n));
+        CHECK(same(v, expected));
+    }
+
+    // uint64_t 区间逐个截断为 limb，用于从累加器写回
+    for (size_t n : {size_t(0), size_t(1), INLINE, INLINE + 1, size_t(64)}) {
+        std::vector<uint64_t> acc(n);
+        Model m(n);
+        for (size_t i = 0; i < n; ++i) {
+            acc[i] = (uint64_t)(BASE - 1 - i);
+            m[i] = BASE - 1 - (limb_t)i;
+        }
+        LimbVector v = make(INLINE + 2, 1);
+        v.assign(acc.begin(), acc.end());
+        CHECK(same(v, m));
+        LimbVector fresh(acc.begin(), acc.end());
+        CHECK(same(fresh, m));
+    }
+    {
+        const std::vector<uint64_t> wide = {(uint64_t(1) << 32) + 5, uint64_t(1) << 40, 7};
+        LimbVector v;
+        v.assign(wide.begin(), wide.end());
+        CHECK(same(v, {5, 0, 7}));
+    }
+
+    // 移动：堆上的缓冲区直接接管，内部的逐个复制；被移走的一方为空并回到内部缓冲区
+    for (size_t n : {size_t(0), size_t(3), INLINE, INLINE + 1, size_t(50)}) {
+        LimbVector source = make(n, 1);
+        const limb_t* data = source.data();
+        const bool heap = n > INLINE;
+        LimbVector moved(std::move(source));
+        CHECK(same(moved, model(n, 1)));
+        CHECK((moved.data() == data) == heap);
+        CHECK(source.empty() && source.capacity() == INLINE);
+        source.push_back(42);
+        CHECK(same(source, {42}));
+
+        // 移动赋值到内部与堆上的目标
+        for (size_t target_size : {size_t(2), size_t(30)}) {
+            LimbVector target = make(target_size, 500);
+            LimbVector from = make(n, 1);
+            const limb_t* from_data = from.data();
+            target = std::move(from);
+            CHECK(same(target, model(n, 1)));
+            CHECK((target.data() == from_data) == heap);
+            CHECK(from.empty() && from.capacity() == INLINE);
+            if (!heap) CHECK(target.capacity() == INLINE);
+        }
+    }
+
+    // 复制：两份互不影响
+    {
+        LimbVector a = make(20, 3), b = make(2, 9);
+        b = a;
+        CHECK(b == a && b.data() != a.data());
+        b[0] = 77;
+        CHECK(a[0] == 3 && b != a);
+        LimbVector c(b);
+        CHECK(c == b);
+        c = make(2, 8);
+        CHECK(same(c, {8, 9}));
+    }
+
+    // 交换：内部与内部、内部与堆、堆与堆，堆上的缓冲区随内容一起换过去
+    for (size_t na : {size_t(2), size_t(20)}) {
+        for (size_t nb : {size_t(0), size_t(5), size_t(33)}) {
+            LimbVector a = make(na, 1000), b = make(nb, 2000);
+            const limb_t* a_data = a.data();
+            const limb_t* b_data = b.data();
+            a.swap(b);
+            CHECK(same(a, model(nb, 2000)) && same(b, model(na, 1000)));
+            if (na > INLINE) CHECK(b.data() == a_data);
+            if (nb > INLINE) CHECK(a.data() == b_data);
+            a.swap(b);
+            CHECK(same(a, model(na, 1000)) && same(b, model(nb, 2000)));
+            a.push_back(1);
+            b.push_back(2);
+            CHECK(a.back() == 1 && b.back() == 2);
+        }
+    }
+    return check_result();
+}
@@ -0,0 +1,45 @@
+#include "check.h"
+
+// NTT 乘法与竖式乘法逐个比较，包括超过单次变换上限后的拆分路径
+
+using namespace Biginteger;
+
+static void check_against_schoolbook(std::mt19937_64& rng, size_t na, size_t nb) {
+    const BigInteger a = random_number(rng, na, rng() % 2), b = random_number(rng, nb, rng() % 2);
+    const BigInteger expected = multiply_abs(a, b);
+    CHECK(NTT_multiply(a, b) == expected);
+    CHECK(NTT_multiply(b, a) == expected);
+    CHECK(NTT_multiply(a, a) == multiply_abs(a, a));
+    CHECK(NTT_multiply(negate(a), b) == negate(expected));
+}
+
+int main() {
+    std::mt19937_64 rng(2025);
+
+    const size_t sizes[] = {1, 2, 3, 17, 100, 257, 1000};
+    for (size_t na : sizes)
+        for (size_t nb : sizes) check_against_schoolbook(rng, na, nb);
+    CHECK(NTT_multiply(from_longlong(0), random_number(rng, 50)) == from_longlong(0));
+
+    // 单次变换上限调低后走 Karatsuba 拆分：平衡、悬殊和需要多层拆分的情形
+    for (size_t limit : {4, 64, 500}) {
+        ThresholdGuard guard;
+        thresholds().ntt_max = limit;
+        const size_t split_sizes[][2] = {{3, 2}, {40, 33}, {300, 299}, {777, 5}, {1500, 400}, {2000, 2000}};
+        for (const auto& s : split_sizes) check_against_schoolbook(rng, s[0], s[1]);
+    }
+
+    // operator* 在调低的阈值下经由 FFT/NTT 与拆分完成
+    ThresholdGuard guard;
+    thresholds().karatsuba = 8;
+    thresholds().toom3 = thresholds().toom4 = 12;
+    thresholds().fft = 16;
+    thresholds().ntt = 64;
+    thresholds().ntt_max = 256;
+    for (int i = 0; i < 40; ++i) {
+        const size_t na = 1 + rng() % 600, nb = 1 + rng() % 600;
+        const BigInteger a = random_number(rng, na), b = random_number(rng, nb);
+        CHECK(a * b == multiply_abs(a, b));
+    }
+    return check_result();
+}
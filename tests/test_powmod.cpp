@@ -0,0 +1,94 @@
+#include "check.h"
+
+// 模幂：单 limb 模数的 uint64_t 路径、Montgomery 与 Barrett 两种约简，和逐位平方取余的结果比较
+
+using namespace Biginteger;
+
+// 从低位起逐位平方，每步用 % 取余
+static BigInteger reference(BigInteger base, BigInteger exp, const BigInteger& m) {
+    BigInteger result = from_longlong(1) % m;
+    base = base % m;
+    if (base.is_negative) base += m;
+    while (!(exp == from_longlong(0))) {
+        if (divmod_small(exp, 2)) result = result * base % m;
+        base = base * base % m;
+    }
+    return result;
+}
+
+int main() {
+    std::mt19937_64 rng(21);
+
+    // 单 limb 模数：各种窗口宽度对应的指数长度，以及偶数、含因子 5 的模数
+    const long long moduli[] = {1, 2, 10, 999999937, 999999999, 123456789, 65536};
+    for (long long m : moduli) {
+        const BigInteger mod = from_longlong(m);
+        for (size_t limbs : {1, 2, 3, 10, 30, 120}) {
+            const BigInteger base = random_number(rng, 2), exp = random_number(rng, limbs, rng() % 2);
+            CHECK(powmod(base, exp, mod) == reference(base, exp, mod));
+        }
+        CHECK(powmod(from_longlong(7), from_longlong(0), mod) == from_longlong(1) % mod);
+        CHECK(powmod(from_longlong(0), from_longlong(5), mod) == from_longlong(0));
+    }
+    // 费马小定理：999999937 是素数
+    CHECK(powmod(from_longlong(123456), from_longlong(999999936), from_longlong(999999937)) == from_longlong(1));
+    CHECK(powmod(from_longlong(-3), from_longlong(5), from_longlong(1000)) == from_longlong(757));
+
+    // 多 limb 模数：奇数模数走 Montgomery，偶数走 Barrett
+    for (size_t n : {2, 5, 17}) {
+        BigInteger odd = random_number(rng, n), even = random_number(rng, n);
+        if (odd.digits[0] % 2 == 0) odd.digits[0] += 1;
+        if (odd.digits[0] % 5 == 0) odd.digits[0] += 2;
+        if (even.digits[0] % 2 != 0) even.digits[0] -= 1;
+        for (const BigInteger& m : {odd, even}) {
+            const ModContext ctx = mod_context(m);
+            const BigInteger base = random_number(rng, n + 3), exp = random_number(rng, 4);
+            CHECK(powmod(ctx, base, exp) == reference(base, exp, m));
+        }
+    }
+
+    // 模数不短于 FFT 阈值时 Montgomery 改用两次乘法约简，m^{-1} mod BASE^n 由 Hensel 提升求出：
+    // 调低阈值覆盖多种长度，再用默认阈值跑一个 256 limb 的模数
+    auto odd_modulus = [&](size_t n) {
+        BigInteger m = random_number(rng, n);
+        m.digits[0] = (limb_t)(rng() % (BASE / 10)) * 10 + 7;
+        return m;
+    };
+    {
+        ThresholdGuard guard;
+        thresholds().fft = 8;
+        for (size_t n : {8, 9, 20, 41}) {
+            const BigInteger m = odd_modulus(n);
+            const ModContext ctx = mod_context(m);
+            CHECK(!ctx.inverse.digits.empty());
+            const BigInteger base = random_number(rng, n + 1), exp = random_number(rng, 3);
+            CHECK(powmod(ctx, base, exp) == reference(base, exp, m));
+        }
+    }
+    const BigInteger big = odd_modulus(256);
+    const ModContext big_ctx = mod_context(big);
+    CHECK(!big_ctx.inverse.digits.empty());
+    const BigInteger big_base = random_number(rng, 300), big_exp = random_number(rng, 2);
+    CHECK(powmod(big_ctx, big_base, big_exp) == reference(big_base, big_exp, big));
+
+    // mod_reduce、mod_mul 的输入长于 2n 时先做一次除法，负数化到 [0, m)
+    for (size_t n : {1, 3, 30}) {
+        const BigInteger m = odd_modulus(n);
+        const ModContext ctx = mod_context(m);
+        BigInteger x = random_number(rng, 2 * n + 5), y = random_number(rng, 3 * n + 2);
+        BigInteger expected = x % m;
+        CHECK(mod_reduce(ctx, x) == expected);
+        x.is_negative = true;
+        expected = (m - expected) % m;
+        CHECK(mod_reduce(ctx, x) == expected);
+        CHECK(mod_mul(ctx, x, y) == (expected * (y % m)) % m);
+        CHECK(mod_mul(ctx, y, y) == (y % m) * (y % m) % m);
+    }
+
+    // 负指数对模逆求幂
+    const BigInteger m = from_longlong(1000003);
+    CHECK(powmod(from_longlong(5), from_longlong(-2), m) * from_longlong(25) % m == from_longlong(1));
+    CHECK_THROWS(powmod(from_longlong(2), from_longlong(-1), from_longlong(10)), std::invalid_argument);
+    CHECK_THROWS(powmod(from_longlong(2), from_longlong(3), from_longlong(0)), std::invalid_argument);
+    return check_result();
+}
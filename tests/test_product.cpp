@@ -0,0 +1,82 @@
+#include "check.h"
+
+// 乘积树、阶乘、二项式系数与素数阶乘：和逐个乘上小整数或竖式乘法的结果比较；
+// 也覆盖长短悬殊的乘法，它按短操作数切段后原地累加
+
+using namespace Biginteger;
+
+// 1 · 2 · ... · n，每步只乘一个机器字
+static BigInteger sequential_factorial(int64_t n) {
+    BigInteger result = from_longlong(1);
+    for (int64_t i = 2; i <= n; ++i) result *= i;
+    return result;
+}
+
+static bool is_prime(int64_t n) {
+    if (n < 2) return false;
+    for (int64_t d = 2; d * d <= n; ++d)
+        if (n % d == 0) return false;
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(24);
+
+    for (int64_t n : {0, 1, 2, 3, 10, 20, 21, 100, 1000, 3000, 6000})
+        CHECK(factorial(n) == sequential_factorial(n));
+    CHECK(factorial(20) == from_longlong(2432902008176640000));
+    CHECK_THROWS(factorial(-1), std::invalid_argument);
+
+    // k 不在 [0, n] 内时为 0，k = 0 或 n 时为 1
+    CHECK(binomial(10, -1) == from_longlong(0));
+    CHECK(binomial(10, 11) == from_longlong(0));
+    CHECK(binomial(10, 0) == from_longlong(1));
+    CHECK(binomial(10, 10) == from_longlong(1));
+    CHECK(binomial(0, 0) == from_longlong(1));
+    CHECK(binomial(52, 5) == from_longlong(2598960));
+    CHECK_THROWS(binomial(-3, 1), std::invalid_argument);
+    // C(n, k) k! (n - k)! = n!
+    for (int64_t k : {1, 7, 300, 1000, 1999}) {
+        const int64_t n = 2000;
+        CHECK(binomial(n, k) * sequential_factorial(k) * sequential_factorial(n - k) == sequential_factorial(n));
+    }
+    // Pascal 恒等式
+    for (int64_t k = 1; k < 300; k += 37)
+        CHECK(binomial(300, k) == binomial(299, k - 1) + binomial(299, k));
+
+    CHECK(primorial(0) == from_longlong(1));
+    CHECK(primorial(1) == from_longlong(1));
+    CHECK(primorial(2) == from_longlong(2));
+    CHECK(primorial(10) == from_longlong(210));
+    CHECK(primorial(30) == from_longlong(6469693230));
+    BigInteger primes = from_longlong(1);
+    for (int64_t p = 2; p <= 5000; ++p)
+        if (is_prime(p)) primes *= p;
+    CHECK(primorial(5000) == primes);
+    CHECK_THROWS(primorial(-1), std::invalid_argument);
+
+    // 空序列的乘积为 1；正负混合、长短不一的因子和逐个竖式相乘比较
+    CHECK(product({}) == from_longlong(1));
+    for (size_t count : {1, 2, 3, 17, 60}) {
+        std::vector<BigInteger> nums;
+        BigInteger expected = from_longlong(1);
+        for (size_t i = 0; i < count; ++i) {
+            BigInteger x = random_number(rng, 1 + rng() % (i % 5 == 0 ? 400 : 20), rng() % 2);
+            x.is_negative = rng() % 3 == 0;
+            expected = reference_multiply(expected, x);
+            nums.push_back(std::move(x));
+        }
+        CHECK(product(nums) == expected);
+    }
+    CHECK(product(std::vector<BigInteger>{from_longlong(-5), from_longlong(0), from_longlong(7)}) == from_longlong(0));
+
+    // 长短悬殊：短的从一个 limb 到超过 FFT 阈值，长的不是短的整数倍
+    const BigInteger long_one = random_number(rng, 12345, true);
+    for (size_t nb : {1, 2, 47, 48, 130, 200, 300, 1000, 4000}) {
+        BigInteger short_one = random_number(rng, nb, rng() % 2);
+        CHECK(long_one * short_one == reference_multiply(long_one, short_one));
+        short_one.is_negative = true;
+        CHECK(short_one * long_one == reference_multiply(short_one, long_one));
+    }
+    return check_result();
+}
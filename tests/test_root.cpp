@@ -0,0 +1,58 @@
+#include "check.h"
+
+// 整数平方根与 k 次方根：r^k <= n < (r+1)^k、余数，以及恰好是幂和幂两侧的边界
+
+using namespace Biginteger;
+
+static BigInteger power(const BigInteger& x, int64_t k) {
+    BigInteger result = from_longlong(1);
+    for (int64_t i = 0; i < k; ++i) result *= x;
+    return result;
+}
+
+static void check_root(const BigInteger& n, int64_t k) {
+    BigInteger remainder;
+    const BigInteger r = iroot(n, k, remainder);
+    CHECK(!r.is_negative);
+    CHECK(compare_abs(power(r, k), n) <= 0 && compare_abs(power(r + 1, k), n) > 0);
+    CHECK(remainder == n - power(r, k));
+    if (k == 2) {
+        BigInteger rest;
+        CHECK(isqrt(n, rest) == r && rest == remainder);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(23);
+
+    // 根超过 16 个 limb 时走倒数平方根与高位递归，更短时是带除法的 Newton
+    for (size_t n : {1, 2, 3, 20, 33, 34, 70, 200, 700}) {
+        for (int64_t k : {2, 3, 5, 7, 31}) {
+            check_root(random_number(rng, n, rng() % 2), k);
+            const BigInteger r = random_number(rng, (n + k - 1) / k);
+            const BigInteger p = power(r, k);
+            CHECK(iroot(p, k) == r);
+            CHECK(iroot(p - 1, k) == r - 1);
+            CHECK(iroot(p + 1, k) == r);
+            check_root(p - 1, k);
+        }
+    }
+    check_root(shift_left(from_longlong(1), 64), 2);
+    check_root(shift_left(from_longlong(1), 64), 3);
+
+    CHECK(isqrt(from_longlong(0)) == from_longlong(0));
+    CHECK(isqrt(from_longlong(1)) == from_longlong(1));
+    CHECK(isqrt(from_longlong(99)) == from_longlong(9));
+    CHECK(iroot(from_longlong(1000), 1) == from_longlong(1000));
+    CHECK(iroot(from_longlong(1) + 1, 200) == from_longlong(1));
+
+    // 负数的奇次方根向零截断，余数与 num 同号
+    BigInteger remainder;
+    CHECK(iroot(from_longlong(-30), 3, remainder) == from_longlong(-3));
+    CHECK(remainder == from_longlong(-3));
+
+    CHECK_THROWS(isqrt(from_longlong(-4)), std::invalid_argument);
+    CHECK_THROWS(iroot(from_longlong(-4), 2), std::invalid_argument);
+    CHECK_THROWS(iroot(from_longlong(8), 0), std::invalid_argument);
+    return check_result();
+}
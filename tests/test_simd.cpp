@@ -0,0 +1,98 @@
+#include "check.h"
+
+// 逐级切换 SIMD 内核：加减法的进位/借位穿过向量通道和块的边界，长度不是 8 或 16 的整数倍；
+// 每一级（包括标量级）的结果都和逐 limb 的参考实现比较，因而彼此一致。竖式乘法共用同一组内核，也一起核对
+
+using namespace Biginteger;
+
+using Limbs = std::vector<limb_t>;
+
+static Limbs sparse_limbs(std::mt19937_64& rng, size_t n) {
+    Limbs v(n);
+    for (auto& limb : v) {
+        const uint64_t r = rng() % 8;
+        limb = r < 3 ? 0 : r < 7 ? BASE - 1 : (limb_t)(rng() % BASE);
+    }
+    return v;
+}
+
+static limb_t reference_add(Limbs& out, const Limbs& x, const Limbs& y) {
+    limb_t carry = 0;
+    out.resize(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        const uint64_t cur = (uint64_t)x[i] + (i < y.size() ? y[i] : 0) + carry;
+        carry = cur >= BASE;
+        out[i] = (limb_t)(carry ? cur - BASE : cur);
+    }
+    return carry;
+}
+
+static limb_t reference_sub(Limbs& out, const Limbs& x, const Limbs& y) {
+    limb_t borrow = 0;
+    out.resize(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        int64_t cur = (int64_t)x[i] - (i < y.size() ? y[i] : 0) - borrow;
+        borrow = cur < 0;
+        out[i] = (limb_t)(borrow ? cur + BASE : cur);
+    }
+    return borrow;
+}
+
+static void check_level(std::mt19937_64& rng) {
+    for (size_t ny : {1, 7, 9, 15, 17, 31, 33, 63, 100, 257}) {
+        for (size_t nx : {ny, ny + 1, ny + 13}) {
+            Limbs x = sparse_limbs(rng, nx), y = sparse_limbs(rng, ny);
+            // 减法要求 x >= y
+            if (nx > ny) x.back() = std::max<limb_t>(x.back(), 1);
+            else if (std::lexicographical_compare(x.rbegin(), x.rend(), y.rbegin(), y.rend())) std::swap(x, y);
+            Limbs expected, out(nx);
+            limb_t carry = reference_add(expected, x, y);
+            CHECK(add_limbs(out.data(), x.data(), nx, y.data(), ny) == carry && out == expected);
+            CHECK(reference_sub(expected, x, y) == 0);
+            CHECK(sub_limbs(out.data(), x.data(), nx, y.data(), ny) == 0 && out == expected);
+
+            // out 与 x 相同
+            Limbs inplace = x;
+            carry = reference_add(expected, x, y);
+            CHECK(add_limbs(inplace.data(), inplace.data(), nx, y.data(), ny) == carry && inplace == expected);
+            inplace = x;
+            reference_sub(expected, x, y);
+            CHECK(sub_limbs(inplace.data(), inplace.data(), nx, y.data(), ny) == 0 && inplace == expected);
+        }
+
+        // 全是 BASE - 1 加 1、BASE^ny 减 1：进位和借位一路传到最高位
+        const Limbs nines(ny, BASE - 1), zeros(ny, 0), one = {1};
+        Limbs out(ny);
+        CHECK(add_limbs(out.data(), nines.data(), ny, one.data(), 1) == 1 && out == zeros);
+        CHECK(add_limbs(out.data(), nines.data(), ny, nines.data(), ny) == 1);
+        Limbs power(ny + 1, 0), rest(ny + 1);
+        power[ny] = 1;
+        CHECK(sub_limbs(rest.data(), power.data(), ny + 1, one.data(), 1) == 0);
+        CHECK(std::equal(nines.begin(), nines.end(), rest.begin()) && rest[ny] == 0);
+        CHECK(sub_limbs(out.data(), nines.data(), ny, nines.data(), ny) == 0 && out == zeros);
+    }
+
+    for (size_t n : {1, 5, 17, 40, 90}) {
+        const BigInteger a = random_number(rng, n + 3, true), b = random_number(rng, n, true);
+        Limbs out(a.digits.size() + b.digits.size());
+        multiply_limbs(out.data(), a.digits.data(), a.digits.size(), b.digits.data(), b.digits.size());
+        BigInteger p;
+        p.digits.assign(out.data(), out.data() + out.size());
+        remove_leading_zeros(p);
+        CHECK(p == reference_multiply(a, b));
+    }
+}
+
+int main() {
+    const SimdLevel saved = simd_level();
+    for (int level = 0; level <= (int)cpu_simd_level(); ++level) {
+        set_simd_level((SimdLevel)level);
+        CHECK(simd_level() == (SimdLevel)level);
+        // 每一级用同一个种子，输入相同
+        std::mt19937_64 rng(12);
+        check_level(rng);
+    }
+    if (cpu_simd_level() < SimdLevel::AVX512) CHECK_THROWS(set_simd_level(SimdLevel::AVX512), std::invalid_argument);
+    set_simd_level(saved);
+    return check_result();
+}
@@ -0,0 +1,158 @@
+#include "check.h"
+
+#include <climits>
+
+// 与机器整数的运算：k 取 INT64_MIN/INT64_MAX、±BASE、BASE ± 1 等边界，被操作数取 int64 范围内的值时
+// 和 __int128 的精确结果比较，取多 limb 的值时和 BigInteger 之间的运算比较；除法核对余数的符号
+
+using namespace Biginteger;
+
+static BigInteger from_int128(__int128 v) {
+    const bool negative = v < 0;
+    unsigned __int128 m = negative ? 0 - (unsigned __int128)v : (unsigned __int128)v;
+    std::string s;
+    do {
+        s.insert(s.begin(), char('0' + (int)(m % 10)));
+        m /= 10;
+    } while (m);
+    return from_string((negative ? "-" : "") + s);
+}
+
+static const int64_t B = BASE;
+static const int64_t EDGES[] = {
+    0, 1, -1, 2, -7,
+    B - 1, B, B + 1, -(B - 1), -B, -(B + 1),
+    B * B - 1, B * B, -(B * B + 1), 999999999999999999,
+    INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1,
+};
+
+static int sign(__int128 v) { return v < 0 ? -1 : (v > 0 ? 1 : 0); }
+
+// a 与 k 都在 int64 范围内：所有运算都能用 __int128 精确算出
+static void check_exact(int64_t a, int64_t k, int64_t c) {
+    const BigInteger x = from_longlong(a);
+    const __int128 wa = a, wk = k, wc = c;
+
+    CHECK(identical(x + k, from_int128(wa + wk)));
+    CHECK(identical(x - k, from_int128(wa - wk)));
+    CHECK(identical(x * k, from_int128(wa * wk)));
+    CHECK(identical(k * x, from_int128(wa * wk)));
+    BigInteger y = x;
+    mul_add_small(y, k, c);
+    CHECK(identical(y, from_int128(wa * wk + wc)));
+    CHECK(compare_small(x, k) == sign(wa - wk));
+
+    if (k != 0) {
+        // C++ 的 / 与 % 向零截断，__int128 下 INT64_MIN / -1 也不溢出
+        const __int128 q = wa / wk, r = wa % wk;
+        BigInteger z = x;
+        CHECK(divmod_small(z, k) == (int64_t)r);
+        CHECK(identical(z, from_int128(q)));
+        CHECK(identical(x / k, from_int128(q)));
+        CHECK(x % k == (int64_t)r);
+        z = x;
+        z %= k;
+        CHECK(identical(z, from_int128(r)));
+    }
+}
+
+// 多 limb 的 a：加减和 BigInteger 之间的加减比较，乘法和竖式乘法比较，除法核对 q · d + r = a
+static void check_wide(const BigInteger& a, int64_t k, int64_t c) {
+    const BigInteger wk = from_longlong(k), wc = from_longlong(c);
+
+    CHECK(identical(a + k, a + wk));
+    CHECK(identical(a - k, a - wk));
+    CHECK(identical(BigInteger(a) + k, a + wk));
+    CHECK(identical(BigInteger(a) - k, a - wk));
+    const BigInteger product = reference_multiply(a, wk);
+    CHECK(identical(a * k, product));
+    CHECK(identical(BigInteger(a) * k, product));
+    BigInteger y = a;
+    y += k;
+    CHECK(identical(y, a + wk));
+    y = a;
+    y -= k;
+    CHECK(identical(y, a - wk));
+    y = a;
+    y *= k;
+    CHECK(identical(y, product));
+    y = a;
+    mul_add_small(y, k, c);
+    CHECK(identical(y, product + wc));
+
+    const int cmp = a < wk ? -1 : (a == wk ? 0 : 1);
+    CHECK(compare_small(a, k) == cmp);
+    CHECK((a < k) == (cmp < 0) && (a > k) == (cmp > 0) && (a == k) == (cmp == 0));
+    CHECK((a <= k) == (cmp <= 0) && (a >= k) == (cmp >= 0));
+
+    if (k == 0) return;
+    BigInteger q = a;
+    const int64_t r = divmod_small(q, k);
+    CHECK(canonical(q));
+    CHECK(reference_multiply(q, wk) + from_longlong(r) == a);
+    // |r| < |k|，余数与被除数同号，商的符号由两者决定
+    CHECK(absolute(from_longlong(r)) < absolute(wk));
+    CHECK(r == 0 || (r < 0) == a.is_negative);
+    CHECK(is_zero(q) || q.is_negative == (a.is_negative != (k < 0)));
+    CHECK(identical(a / k, q));
+    CHECK(identical(BigInteger(a) / k, q));
+    CHECK(a % k == r);
+    y = a;
+    y /= k;
+    CHECK(identical(y, q));
+    y = a;
+    y %= k;
+    CHECK(identical(y, from_longlong(r)));
+}
+
+int main() {
+    std::mt19937_64 rng(8);
+
+    for (int64_t a : EDGES)
+        for (int64_t k : EDGES)
+            for (int64_t c : {int64_t(0), int64_t(5), int64_t(-5), B, -B, INT64_MAX, INT64_MIN})
+                check_exact(a, k, c);
+
+    // 多 limb 的被操作数：乘数为 BASE 的倍数或不小于 BASE 时拆成多个 limb，进位延伸到新的最高位
+    for (size_t limbs : {1, 2, 3, 4, 10, 57}) {
+        for (int round = 0; round < 4; ++round) {
+            BigInteger a = random_number(rng, limbs, round % 2);
+            a.is_negative = round >= 2;
+            for (int64_t k : EDGES)
+                for (int64_t c : {int64_t(3), int64_t(-3), INT64_MAX, INT64_MIN})
+                    check_wide(a, k, c);
+        }
+    }
+
+    // 乘积与 c 异号：c 的幅值超过乘积时结果变号
+    {
+        BigInteger x = from_longlong(-3);
+        mul_add_small(x, 2, INT64_MAX);
+        CHECK(identical(x, from_int128((__int128)INT64_MAX - 6)));
+        x = from_longlong(3);
+        mul_add_small(x, B, INT64_MIN);
+        CHECK(identical(x, from_int128((__int128)3 * B + INT64_MIN)));
+        x = from_longlong(0);
+        mul_add_small(x, INT64_MIN, -1);
+        CHECK(identical(x, from_longlong(-1)));
+    }
+
+    // 恰好能放进 int64 的值和刚刚放不下的值
+    const BigInteger max = from_string("9223372036854775807"), over = from_string("9223372036854775808");
+    const BigInteger min = from_string("-9223372036854775808"), under = from_string("-9223372036854775809");
+    CHECK(compare_small(max, INT64_MAX) == 0 && max == INT64_MAX);
+    CHECK(compare_small(over, INT64_MAX) == 1 && over > INT64_MAX);
+    CHECK(compare_small(min, INT64_MIN) == 0 && min == INT64_MIN);
+    CHECK(compare_small(under, INT64_MIN) == -1 && under < INT64_MIN);
+    CHECK(compare_small(max, INT64_MIN) == 1 && compare_small(min, INT64_MAX) == -1);
+    CHECK(compare_small(from_string("999999999999999999999999999"), INT64_MAX) == 1);
+    CHECK(compare_small(from_string("-1000000000000000000000000000"), INT64_MIN) == -1);
+    CHECK(identical(over - 1, max) && identical(under + 1, min));
+    CHECK(identical(min - INT64_MIN, from_longlong(0)) && identical(max + INT64_MIN, from_longlong(-1)));
+
+    BigInteger x = from_longlong(7);
+    CHECK_THROWS(divmod_small(x, 0), std::invalid_argument);
+    CHECK_THROWS(x % 0, std::invalid_argument);
+    CHECK_THROWS(x /= 0, std::invalid_argument);
+    return check_result();
+}
@@ -0,0 +1,35 @@
+#include "check.h"
+
+#include <sstream>
+
+// 十进制字符串与 limb 之间的转换：往返一致、前导零与符号、非法输入
+
+using namespace Biginteger;
+
+int main() {
+    std::mt19937_64 rng(3);
+
+    for (size_t n : {1, 2, 9, 100, 1000}) {
+        BigInteger a = random_number(rng, n, rng() % 2);
+        CHECK(from_string(to_string(a)) == a);
+        a.is_negative = true;
+        CHECK(from_string(to_string(a)) == a);
+    }
+
+    CHECK(to_string(from_string("000000000000123")) == "123");
+    CHECK(to_string(from_string("-0")) == "0");
+    CHECK(to_string(from_string("+1000000000")) == "1000000000");
+    CHECK(to_string(from_string("-999999999999999999")) == "-999999999999999999");
+
+    // 默认构造的 BigInteger 没有 limb，按 0 输出
+    const BigInteger empty;
+    CHECK(to_string(empty) == "0");
+    std::ostringstream os;
+    os << empty;
+    CHECK(os.str() == "0");
+
+    CHECK_THROWS(from_string(""), std::invalid_argument);
+    CHECK_THROWS(from_string("-"), std::invalid_argument);
+    CHECK_THROWS(from_string("12a4"), std::invalid_argument);
+    return check_result();
+}
@@ -0,0 +1,62 @@
+#include "check.h"
+
+#include <atomic>
+#include <functional>
+
+// 线程池：嵌套的 fork-join、异常传递、parallel_for 的分块，以及并行乘法与串行结果一致
+
+using namespace Biginteger;
+
+// 每层分出 width 个任务，递归 depth 层，叶子计数
+static void nested(std::atomic<size_t>& leaves, size_t width, size_t depth) {
+    if (depth == 0) {
+        leaves.fetch_add(1);
+        return;
+    }
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < width; ++i) tasks.push_back([&leaves, width, depth] { nested(leaves, width, depth - 1); });
+    parallel_invoke(tasks, PARALLEL_THRESHOLD);
+}
+
+int main() {
+    const size_t threads = thread_count();
+    std::mt19937_64 rng(5);
+
+    for (size_t n : {1, 2, 4, 7}) {
+        set_thread_count(n);
+        CHECK(thread_count() == n);
+
+        std::atomic<size_t> leaves{0};
+        nested(leaves, 3, 6);
+        CHECK(leaves.load() == 729);
+
+        // 任务抛出的异常在等待方重新抛出
+        std::vector<std::function<void()>> tasks;
+        for (int i = 0; i < 8; ++i)
+            tasks.push_back([i] {
+                if (i % 3 == 1) throw std::invalid_argument("task failed");
+            });
+        CHECK_THROWS(parallel_invoke(tasks, PARALLEL_THRESHOLD), std::invalid_argument);
+
+        std::vector<uint64_t> values(100000);
+        parallel_for(0, values.size(), 1000, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) values[i] = i * i;
+        });
+        bool all = true;
+        for (size_t i = 0; i < values.size(); ++i) all &= values[i] == i * i;
+        CHECK(all);
+
+        // 调低并行阈值后乘法的各层子乘积都交给线程池
+        ThresholdGuard guard;
+        thresholds().parallel = 16;
+        thresholds().karatsuba = 8;
+        thresholds().toom3 = 32;
+        thresholds().toom4 = 96;
+        for (size_t limbs : {50, 200, 1500}) {
+            const BigInteger a = random_number(rng, limbs), b = random_number(rng, limbs - 7);
+            CHECK(a * b == multiply_abs(a, b));
+        }
+    }
+    set_thread_count(threads);
+    return check_result();
+}
@@ -0,0 +1,87 @@
+#include "check.h"
+
+// Toom-3/Toom-4 与竖式乘法比较：平衡、最高段不足或为空的形状，以及递归进入下一层 Toom 的情形；
+// 区间乘法 mul_limbs 中长度悬殊的分段与直接写进 out 的 FFT/NTT 子乘积
+
+using namespace Biginteger;
+
+static void check_shape(std::mt19937_64& rng, size_t na, size_t nb) {
+    const BigInteger a = random_number(rng, na, rng() % 2), b = random_number(rng, nb, rng() % 2);
+    const BigInteger expected = multiply_abs(a, b);
+    CHECK(toom3(a, b) == expected);
+    CHECK(toom4(a, b) == expected);
+    CHECK(toom3(b, a) == expected);
+    CHECK(toom4(a, a) == multiply_abs(a, a));
+    CHECK(a * b == expected);
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+
+    // 阈值调低，Toom 的子乘积还会递归进入 Karatsuba 与 Toom
+    ThresholdGuard guard;
+    thresholds().karatsuba = 4;
+    thresholds().toom3 = 8;
+    thresholds().toom4 = 24;
+
+    for (size_t na = 4; na <= 40; ++na)
+        for (size_t nb = na / 2 + 1; nb <= na; ++nb) check_shape(rng, na, nb);
+    for (int i = 0; i < 60; ++i) {
+        const size_t na = 40 + rng() % 500, nb = na / 2 + 1 + rng() % (na - na / 2);
+        check_shape(rng, na, nb);
+    }
+
+    // 并行时子乘积各用一段临时空间
+    const size_t threads = thread_count();
+    thresholds().parallel = 8;
+    set_thread_count(4);
+    for (int i = 0; i < 20; ++i) {
+        const size_t na = 50 + rng() % 300, nb = na / 2 + 1 + rng() % (na - na / 2);
+        check_shape(rng, na, nb);
+    }
+    set_thread_count(threads);
+
+    // 操作数全为 0 或 BASE - 1 的段时求值和插值的中间值最大
+    thresholds().parallel = PARALLEL_THRESHOLD;
+    for (size_t na : {24, 97, 300}) {
+        const BigInteger a = random_number(rng, na, true);
+        BigInteger top;
+        top.digits.assign(na, BASE - 1);
+        CHECK(toom3(top, top) == multiply_abs(top, top));
+        CHECK(toom4(top, top) == multiply_abs(top, top));
+        CHECK(toom4(a, top) == multiply_abs(a, top));
+    }
+
+    // Karatsuba/Toom 内部长度悬殊的子乘积与达到 FFT/NTT 阈值的子乘积都在区间上完成；
+    // 区间带前导零，out 的内容事先是垃圾
+    thresholds().fft = 40;
+    thresholds().ntt = 200;
+    for (int i = 0; i < 40; ++i) {
+        const size_t na = 1 + rng() % 900, nb = 1 + rng() % 300;
+        BigInteger a = random_number(rng, na, rng() % 2), b = random_number(rng, nb, rng() % 2);
+        if (i % 4 == 0) a.digits.back() = 0;
+        std::vector<limb_t> out(na + nb, BASE - 1), scratch(mul_scratch(na, nb));
+        mul_limbs(out.data(), a.digits.data(), na, b.digits.data(), nb, scratch.data());
+        BigInteger p;
+        p.digits.assign(out.begin(), out.end());
+        remove_leading_zeros(p);
+        remove_leading_zeros(a);
+        CHECK(p == reference_multiply(a, b));
+        CHECK(a * b == reference_multiply(a, b));
+    }
+    for (size_t n : {1, 50, 333}) {
+        const BigInteger a = random_number(rng, n), b = random_number(rng, n + 7);
+        std::vector<limb_t> out(2 * n + 7, 1);
+        fft_limbs(out.data(), a.digits.data(), n, b.digits.data(), n + 7);
+        BigInteger p;
+        p.digits.assign(out.begin(), out.end());
+        remove_leading_zeros(p);
+        CHECK(p == reference_multiply(a, b));
+        std::fill(out.begin(), out.end(), 1);
+        ntt_limbs(out.data(), a.digits.data(), n, b.digits.data(), n + 7);
+        p.digits.assign(out.begin(), out.end());
+        remove_leading_zeros(p);
+        CHECK(p == reference_multiply(a, b));
+    }
+    return check_result();
+}
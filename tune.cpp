@@ -0,0 +1,125 @@
+#include <BigInteger/biginteger.h>
+#include <chrono>
+#include <functional>
+#include <random>
+
+// 逐级比较相邻两种乘法、除法算法，找出本机上的切换点并写入配置文件
+// 用法：tune [输出文件]，之后设置 BIGINTEGER_TUNING=<输出文件> 或调用 load_thresholds
+
+using namespace Biginteger;
+
+static std::mt19937_64 rng(20240601);
+
+static BigInteger random_number(size_t limbs) {
+    BigInteger num;
+    num.digits.resize(limbs);
+    for (auto& limb : num.digits) limb = rng() % BASE;
+    if (num.digits.back() == 0) num.digits.back() = 1;
+    return num;
+}
+
+// 重复运行到至少 min_ms，取每轮平均耗时的中位数
+static double measure(const std::function<void()>& f, double min_ms = 4.0) {
+    std::vector<double> samples;
+    for (int round = 0; round < 5; ++round) {
+        int reps = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            f();
+            ++reps;
+            elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < min_ms / 5);
+        samples.push_back(elapsed / reps);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+using Multiply = std::function<BigInteger(const BigInteger&, const BigInteger&)>;
+
+// 在 [lo, hi] 上按约 1.2 倍步长扫描，新算法连续两个尺寸更快时的第一个尺寸即为切换点
+static size_t crossover(const char* name, const Multiply& old_alg, const Multiply& new_alg,
+                        size_t lo, size_t hi, const std::function<void(size_t)>& prepare) {
+    size_t found = hi;
+    int wins = 0;
+    size_t first_win = hi;
+    for (size_t n = lo; n <= hi; n = std::max(n + 1, n * 6 / 5)) {
+        prepare(n);
+        BigInteger a = random_number(n), b = random_number(n);
+        double t_old = measure([&] { old_alg(a, b); });
+        double t_new = measure([&] { new_alg(a, b); });
+        std::cout << "  " << name << " n=" << n << " old " << t_old << "ms new " << t_new << "ms\n";
+        if (t_new < t_old) {
+            if (wins++ == 0) first_win = n;
+            if (wins == 2) {
+                found = first_win;
+                break;
+            }
+        } else {
+            wins = 0;
+        }
+    }
+    std::cout << name << " threshold: " << found << "\n";
+    return found;
+}
+
+int main(int argc, char** argv) {
+    const std::string output = argc > 1 ? argv[1] : "bigint_tuning.conf";
+    const size_t NEVER = std::numeric_limits<size_t>::max() / 4;
+
+    // 调某一级时更高的级别全部关闭，被测算法在当前尺寸下只作用于最外层
+    Thresholds& t = thresholds();
+    t = Thresholds{};
+    t.toom3 = t.toom4 = t.fft = NEVER;
+
+    t.karatsuba = crossover("karatsuba", multiply_abs, karatsuba, 8, 512,
+                            [&](size_t n) { t.karatsuba = n; });
+    t.toom3 = crossover("toom3", karatsuba, toom3, t.karatsuba, 2048,
+                        [&](size_t n) { t.toom3 = n; });
+    t.toom4 = crossover("toom4", toom3, toom4, t.toom3, 4096,
+                        [&](size_t n) { t.toom4 = n; });
+    t.fft = crossover("fft", multiply_dispatch, FFT_multiply, t.karatsuba, 8192,
+                      [&](size_t) {});
+    t.toom4 = std::min(t.toom4, t.fft);
+    t.toom3 = std::min(t.toom3, t.toom4);
+
+    // NTT 阈值按两操作数总长比较，且不超过 FFT 的精度上限
+    t.ntt = 2 * crossover("ntt", FFT_multiply, NTT_multiply, t.fft, NTT_THRESHOLD / 2,
+                          [&](size_t) {});
+
+    // 除法以 2n/n 为测试规模：被除数为 a * BASE^n + b
+    auto as_division = [](BigInteger (*divide_alg)(const BigInteger&, const BigInteger&, BigInteger&)) {
+        return [divide_alg](const BigInteger& a, const BigInteger& b) {
+            BigInteger remainder;
+            return divide_alg(shift_left(a, a.digits.size()) + b, b, remainder);
+        };
+    };
+    t.bz = t.newton = NEVER;
+    t.bz = crossover("bz", as_division(divide_knuth), as_division(divide_bz), 8, 2048,
+                     [&](size_t n) { t.bz = n; });
+    // 扫描范围内 Newton 始终不占优时保留默认值
+    const size_t newton_limit = 16384;
+    t.newton = crossover("newton", as_division(divide_bz), as_division(divide_newton), t.bz, newton_limit,
+                         [&](size_t) {});
+    if (t.newton >= newton_limit) t.newton = NEWTON_THRESHOLD;
+
+    // 半 GCD 与纯 Lehmer 比较，两个数都是 n 个 limb
+    t.hgcd = crossover("hgcd",
+                       [&](const BigInteger& a, const BigInteger& b) { t.hgcd = NEVER; return gcd(a, b); },
+                       [&](const BigInteger& a, const BigInteger& b) { t.hgcd = a.digits.size(); return gcd(a, b); },
+                       16, 4096, [&](size_t) {});
+
+    // 并行切换点：同一乘法分别关闭和打开线程池比较，单线程机器保留默认值
+    // 阈值与子乘积的长度比较，最外层的子乘积约为 n / 4 到 n / 2
+    if (thread_count() > 1) {
+        t.parallel = crossover("parallel",
+                               [&](const BigInteger& a, const BigInteger& b) { t.parallel = NEVER; return multiply_dispatch(a, b); },
+                               [&](const BigInteger& a, const BigInteger& b) { t.parallel = a.digits.size() / 4; return multiply_dispatch(a, b); },
+                               256, 65536, [&](size_t) {}) / 4;
+    }
+
+    save_thresholds(t, output);
+    std::cout << "written " << output << "\n";
+    return 0;
+}